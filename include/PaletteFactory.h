@@ -6,6 +6,9 @@
 
 #include "util.h"
 #include <FastLED.h>
+#include "global.h"
+
+#define PALETTE_BLEND_STEPS 32      //number of steps a timed palette blend goes through - each step re-expands the palette cache
 
 namespace colTheme {
     class PaletteFactory {
@@ -34,8 +37,122 @@ namespace colTheme {
 
         static CRGBPalette16 randomPalette(uint8_t ofsHue = 0, time_t time = 0);
     };
+
+    /**
+     * Owner of the current palette (<code>palette</code> global) and the target palette (<code>targetPalette</code> global) the current
+     * palette is blended toward. Each palette carries a generation number that increases with every actual change of its colors - consumers
+     * compare generations rather than palette contents. Once the current palette has converged to the target, blending is a no-op.
+     * <p>Blending is timed - <code>blendOver</code> starts a blend that reaches the target in the given time regardless of how often
+     * <code>update</code> is called; effects call <code>update</code> on every frame. The blend advances in <code>PALETTE_BLEND_STEPS</code>
+     * steps rather than on every frame, such that the palette caches are not re-expanded for changes too small to see</p>
+     */
+    class PaletteBlender {
+        CRGBPalette16 cur;
+        CRGBPalette16 tgt;
+        CRGBPalette16 origin;               //palette a timed blend started from
+        uint32_t curGen = 0;
+        uint32_t tgtGen = 0;
+        ulong blendStart = 0;               //time (ms) the timed blend started
+        uint16_t blendDuration = 0;         //timed blend duration (ms), 0 when no timed blend is in progress
+        uint8_t blendAmount = 0;            //amount of target blended in by the timed blend so far
+        bool converged = true;
+    public:
+        inline const CRGBPalette16 &current() const {
+            return cur;
+        }
+
+        inline const CRGBPalette16 &target() const {
+            return tgt;
+        }
+
+        inline uint32_t generation() const {
+            return curGen;
+        }
+
+        inline uint32_t targetGeneration() const {
+            return tgtGen;
+        }
+
+        inline bool isConverged() const {
+            return converged;
+        }
+
+        void setPalette(const CRGBPalette16 &pal);
+
+        void setTarget(const CRGBPalette16 &pal);
+
+        void blendOver(uint16_t durationMs);
+
+        bool update();
+
+    protected:
+        void checkConverged();
+    };
+
+    /**
+     * Expansion of one of the blender's palettes into its 256 colors (linear blending) - indexed lookups replace the per-pixel interpolation done by
+     * <code>ColorFromPalette</code>. The palette is re-expanded on first lookup after its generation has changed - the palette owner does not need
+     * to notify the cache.
+     */
+    class PaletteCache {
+        const PaletteBlender &blender;
+        const bool useTarget;               //whether the cache expands the blender's target palette rather than the current one
+        CRGB colors[256] {};
+        uint32_t expandedGen = 0;           //generation of the palette the colors were expanded from
+        uint32_t refreshes = 0;             //number of times the palette has been expanded
+        bool expanded = false;
+    public:
+        PaletteCache(const PaletteBlender &src, bool target);
+
+        inline uint32_t refreshCount() const {
+            return refreshes;
+        }
+
+        /**
+         * Color of the palette at given index, optionally scaled in brightness - same result as <code>ColorFromPalette(source, index, bright, LINEARBLEND)</code>,
+         * including its brightness rounding: a non-zero brightness is incremented, then non-zero channels are scaled with <code>scale8</code>
+         * (<code>FASTLED_SCALE8_FIXED</code>) - that is <code>c*(bright+2)/256</code>
+         * @param index color index in the palette
+         * @param bright brightness to scale the color to
+         * @return the palette color
+         */
+        inline CRGB color(const uint8_t index, const uint8_t bright = 255) {
+            if (!expanded || (expandedGen != (useTarget ? blender.targetGeneration() : blender.generation())))
+                refresh();
+            CRGB clr = colors[index];
+            if (bright != 255) {
+                const uint16_t scale = bright ? bright + 2 : 0;
+                clr.r = (clr.r * scale) >> 8;
+                clr.g = (clr.g * scale) >> 8;
+                clr.b = (clr.b * scale) >> 8;
+            }
+            return clr;
+        }
+
+        void invalidate();
+
+    protected:
+        void refresh();
+    };
 }
 
 extern colTheme::PaletteFactory paletteFactory;
+extern colTheme::PaletteBlender paletteBlender;
+extern colTheme::PaletteCache paletteCache;
+extern colTheme::PaletteCache targetPaletteCache;
+
+/**
+ * Drop-in replacement for <code>ColorFromPalette</code> - the lookups into the <code>palette</code> and <code>targetPalette</code> globals
+ * with linear blending are served from their palette caches, any other lookup is passed through to <code>ColorFromPalette</code>
+ */
+inline CRGB ColorFromCache(const CRGBPalette16 &pal, const uint8_t index, const uint8_t brightness = 255, const TBlendType blendType = LINEARBLEND) {
+    if (blendType == LINEARBLEND) {
+        if (&pal == &palette)
+            return paletteCache.color(index, brightness);
+        if (&pal == &targetPalette)
+            return targetPaletteCache.color(index, brightness);
+    }
+    return ColorFromPalette(pal, index, brightness, blendType);
+}
 
 #endif //TEEN_LIGHTFX_PALETTEFACTORY_H
@@ -0,0 +1,48 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_COMPOSITOR_H
+#define TEEN_LIGHTFX_COMPOSITOR_H
+
+#include <Arduino.h>
+#include "global.h"
+
+#define MAX_LAYERS  4       //max number of layers the compositor holds at once
+
+/**
+ * How a layer's pixels are combined with the pixels below
+ * @see https://en.wikipedia.org/wiki/Blend_modes
+ */
+enum BlendMode:uint8_t {BlendNormal, BlendAdd, BlendMultiply, BlendScreen, BlendOverlay};
+
+/**
+ * Stacks a small number of layers over a target color set (typically <code>tpl</code> or the whole strip). The layer buffers are carved from
+ * the <code>frame</code> pixel array - layers are added in order, each taking the next pixels available, until the frame is exhausted or
+ * the compositor is reset. Each layer has its own blend mode and opacity.
+ * <p>All the layers are composited in a single pass over the target pixels; transparent layers (opacity 0) are skipped altogether, black
+ * pixels of the Add and Screen layers (where these modes leave the pixels below unchanged) are skipped individually. Layers are not
+ * skipped for being unchanged since the last frame - the target is rendered anew every frame, the layers apply over it every time</p>
+ */
+class Compositor {
+    struct Layer {
+        uint16_t start;         //offset of the layer's pixels in the frame array
+        uint16_t size;          //number of pixels in the layer
+        BlendMode mode;
+        uint8_t opacity;
+    };
+    Layer layers[MAX_LAYERS] {};
+    uint8_t layerCount = 0;
+    uint16_t used = 0;          //number of frame pixels taken by the layers
+public:
+    int8_t addLayer(uint16_t size, BlendMode mode = BlendNormal, uint8_t opacity = 255);
+    CRGBSet layer(uint8_t index) const;
+    void setOpacity(uint8_t index, uint8_t opacity);
+    void setBlendMode(uint8_t index, BlendMode mode);
+    void composite(CRGBSet &target) const;
+    void reset();
+    uint8_t size() const;
+};
+
+extern Compositor compositor;
+
+#endif //TEEN_LIGHTFX_COMPOSITOR_H
@@ -7,17 +7,35 @@
 // the PWM pin dedicated for LED control - see PinNames for D2
 #define LED_PIN 25
 
+// The strip can be split across up to 4 data lines (outputs), each driven by its own PIO state machine - the outputs shift their pixels
+// out in parallel, dividing the wire time of a frame. Each output takes a contiguous range of the (logical) strip, from its start pixel
+// up to the start of the next output; the last output runs to the end of the strip. Spare pins on the Nano RP2040 Connect: 15 (D3), 16 (D4), 17 (D5)
+// E.g. a 1024 pixel installation on two lines: LED_OUTPUTS 2, LED_OUTPUT_PINS {LED_PIN, 15}, LED_OUTPUT_STARTS {0, 512}
+#define LED_OUTPUTS         1           //number of data lines the strip is split across, 1-4
+#define LED_OUTPUT_PINS     {LED_PIN}   //data pin of each output
+#define LED_OUTPUT_STARTS   {0}         //first pixel of each output, ascending
+
 // LED chipset info
 #define COLOR_ORDER BRG
 #define CHIPSET     WS2811
+// output color curve - applied by the output stage to every frame, see StripOutput
+#define OUTPUT_CORRECTION   TypicalSMD5050  //white balance of the strip's LEDs
+#define OUTPUT_TEMPERATURE  Tungsten100W    //default color temperature
+#define OUTPUT_GAMMA        2.2f            //gamma exponent of the output curve - channel values and brightness are perceptual; 1.0 is linear
+// strip current draw - calibrated for the 12V WS2811 strips (3 LEDs in series per channel), see StripOutput power limiter
+#define POWER_MA_RED        19      //current drawn by a red channel at full intensity, in mA
+#define POWER_MA_GREEN      19      //current drawn by a green channel at full intensity, in mA
+#define POWER_MA_BLUE       19      //current drawn by a blue channel at full intensity, in mA
+#define POWER_MA_IDLE       1       //current drawn by a dark pixel (the WS2811 chip itself), in mA
+#define POWER_BUDGET_MA     6000    //max current the strip may draw from the power supply, in mA - frames estimated above are dimmed to fit
 
 #define MAX_NUM_PIXELS  1024    //maximum number of pixels supported (equivalent of 330ft LED strips). If more are needed, we'd need to revisit memory allocation and PWM timings
 
-#define NUM_PIXELS  170      //number of pixels on the room ceiling and raising pole
-#define FRAME_SIZE  50       //NOTE: frame size must be at least 3 times less than NUM_PIXELS. The frame CRGBArray must fit at least 3 frames
+#define NUM_PIXELS  170      //default number of pixels on the room ceiling and raising pole - a layout.json file on the filesystem overrides it, see readLayout
+#define FRAME_SIZE  50       //template size for the effects repeating a pattern over the strip - shrinks to the strip when that is shorter, see applyLayout
 
-// initial global brightness 0-255
-#define BRIGHTNESS 176
+// initial global brightness 0-255 - perceptual, see OUTPUT_GAMMA
+#define BRIGHTNESS 215
 
 // These are lists and need to be commas instead of dots eg. for IP address 192.168.0.1 use 192,168,0,1 instead
 #define IP_DNS 8,8,8,8          // Google DNS
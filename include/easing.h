@@ -0,0 +1,31 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_EASING_H
+#define TEEN_LIGHTFX_EASING_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+#define EASE_TABLE_BITS     8                           //log2 of number of segments in an easing table
+#define EASE_TABLE_SIZE     (1 << EASE_TABLE_BITS)      //number of segments in an easing table - the table holds one more entry, for x=1.0
+#define EASE_FRAC_BITS      (16 - EASE_TABLE_BITS)      //bits of the Q16 position used for interpolating between table entries
+#define EASE_ONE            ((int32_t)0x00010000)       //1.0 in Q16.16 - easing results are expressed in this scale
+
+/**
+ * Easing curves available - see https://easings.net for their shapes
+ */
+enum EaseCurve:uint8_t {
+    EaseInQuad, EaseOutQuad, EaseInOutQuad,
+    EaseInCubic, EaseOutCubic, EaseInOutCubic,
+    EaseInSine, EaseOutSine, EaseInOutSine,
+    EaseInBounce, EaseOutBounce, EaseInOutBounce,
+    EaseInElastic, EaseOutElastic, EaseInOutElastic,
+    EaseCurveCount
+};
+
+int32_t easeQ16(EaseCurve curve, uint32_t pos);
+fract16 ease16(EaseCurve curve, fract16 x);
+uint16_t ease(EaseCurve curve, uint16_t x, uint16_t lim);
+
+#endif //TEEN_LIGHTFX_EASING_H
@@ -12,6 +12,10 @@
 #include "global.h"
 #include "util.h"
 #include "transition.h"
+#include "led_output.h"
+#include "easing.h"
+#include "compositor.h"
+#include "pixelmap.h"
 #include "FxSchedule.h"
 #include "config.h"
 
@@ -32,6 +36,8 @@ struct Viewport {
 
 void stateLED(CRGB color);
 
+void applyLayout();
+
 void ledStripInit();
 
 void shiftRight(CRGBSet &set, CRGB feedLeft, Viewport vwp = (Viewport)0, uint16_t pos = 1);
@@ -40,6 +46,12 @@ void loopRight(CRGBSet &set, Viewport vwp = (Viewport)0, uint16_t pos = 1);
 
 void shiftLeft(CRGBSet &set, CRGB feedRight, Viewport vwp = (Viewport) 0, uint16_t pos = 1);
 
+void shiftRight(RingSet &ring, CRGB feedLeft, Viewport vwp = (Viewport)0, uint16_t pos = 1);
+
+void loopRight(RingSet &ring, Viewport vwp = (Viewport)0, uint16_t pos = 1);
+
+void shiftLeft(RingSet &ring, CRGB feedRight, Viewport vwp = (Viewport)0, uint16_t pos = 1);
+
 bool spreadColor(CRGBSet &set, CRGB color = BKG, uint8_t gradient = 255);
 
 bool moveBlend(CRGBSet &target, const CRGBSet &segment, fract8 overlay, uint16_t fromPos, uint16_t toPos);
@@ -80,13 +92,13 @@ inline CHSV toHSV(const CRGB &rgb) { return rgb2hsv_approximate(rgb); }
 inline CRGB toRGB(const CHSV &hsv) { CRGB rgb{}; hsv2rgb_rainbow(hsv, rgb); return rgb; }
 
 bool rblend(CRGB &existing, const CRGB &target, const fract8 frOverlay);
+bool rblend16(CRGB16 &existing, const CRGB16 &target, fract8 frOverlay);
 void blendMultiply(CRGBSet &blendLayer, const CRGBSet &topLayer);
 void blendMultiply(CRGB &blendRGB, const CRGB &topRGB);
 void blendScreen(CRGBSet &blendLayer, const CRGBSet &topLayer);
 void blendScreen(CRGB &blendRGB, const CRGB &topRGB);
 void blendOverlay(CRGBSet &blendLayer, const CRGBSet &topLayer);
 void blendOverlay(CRGB &blendRGB, const CRGB &topRGB);
-CRGB adjustBrightness(CRGB color, uint8_t bright);
 void saveState();
 void readState();
 
@@ -124,6 +136,27 @@ void fx_setup();
 
 void fx_run();
 
+/**
+ * What an effect renders one frame into and with - see <code>LedEffect::run</code>. The pixel sets are views over the same buffer: the registry
+ * hands out views over the strip's pixel buffer (<code>ledSet</code>, <code>tpl</code>, <code>others</code>), while benchmarks and previews
+ * render into a buffer of their own without touching the strip.
+ * <p>Effects rendering a repeated pattern may render the template alone and set <code>templateSize</code> - the registry forwards it to the
+ * output stage (see <code>StripOutput::setTemplate</code>), off-screen renders expand the template over the rest of the frame themselves.
+ * Effects that render in high resolution (see <code>StripOutput::setHighRes</code>) render into <code>target16</code> when given one, into
+ * <code>target</code> otherwise.</p>
+ */
+struct RenderContext {
+    CRGBSet &target;                //all the pixels of the frame
+    CRGBSet &tpl;                   //template at the start of the frame - effects rendering repeated patterns replicate it over others
+    CRGBSet &others;                //rest of the frame past the template
+    const CRGBPalette16 &palette;   //current palette - lookups through ColorFromCache are served from the palette cache
+    ulong now;                      //frame time (ms)
+    uint16_t dt;                    //time (ms) elapsed since the effect's previous frame
+    uint8_t brightness;             //brightness the frame is shown at - an effect may override it for the frame it renders
+    uint16_t templateSize;          //size of the template repeated over the frame - set by the effect; 0 when the whole frame is rendered
+    CRGB16 *target16;               //16 bit pixels of the frame, target's size - the output stage's high resolution buffer; nullptr when none
+};
+
 //base class/interface for all effects
 class LedEffect {
 protected:
@@ -132,12 +165,21 @@ protected:
     ulong transOffStart = 0;
     const char* const desc;
     char id[LED_EFFECT_ID_SIZE] {};   //this is name of the class, max 5 characters (plus null terminal)
+    TimingStats runStats;             //duration of the run() calls that rendered a frame
+    TimingStats windDownStats;        //duration of the windDown() calls that pushed a frame to the strip
+    uint32_t missedFrames = 0;        //number of frames that overran into the next frame's scheduled time
 public:
     explicit LedEffect(const char* description);
 
     virtual void setup();
 
-    virtual void run() = 0;
+    /**
+     * Renders one frame of the effect into the render context given. Effects do not push frames to the strip - the effects registry
+     * shows the frame rendered, at the brightness left in the context.
+     * @param ctx render context - target pixels, frame time, palette
+     * @return true if a new frame has been rendered; false if the effect has nothing new to show (e.g. pacing itself)
+     */
+    virtual bool run(RenderContext &ctx) = 0;
 
     virtual bool windDown();
 
@@ -151,7 +193,9 @@ public:
 
     virtual void nextState();
 
-    virtual void loop();
+    void stop();
+
+    virtual bool loop(RenderContext &ctx);
 
     const char *description() const;
 
@@ -167,6 +211,22 @@ public:
         return state;
     }
 
+    inline const TimingStats &runTiming() const {
+        return runStats;
+    }
+
+    inline const TimingStats &windDownTiming() const {
+        return windDownStats;
+    }
+
+    inline uint32_t missedFrameCount() const {
+        return missedFrames;
+    }
+
+    inline void frameMissed() {
+        missedFrames++;
+    }
+
     /**
      * What weight does this effect have when random selection is engaged
      * Subclasses have the opportunity to customize this value by e.g. the current holiday, time, etc., hence changing/reshaping the chances of selecting an effect
@@ -176,6 +236,15 @@ public:
         return 1;
     }
 
+    /**
+     * How much time (in ms) is one frame of this effect allowed to take - this is the period the effects registry calls <code>run()</code> at.
+     * Subclasses rendering at a different pace than the default should override this value.
+     * @return the frame time budget, in milliseconds
+     */
+    virtual inline uint16_t frameBudget() const {
+        return 100;
+    }
+
     virtual ~LedEffect() = default;     // Destructor
 };
 
@@ -187,6 +256,12 @@ private:
     uint16_t effectsCount = 0;
     uint16_t lastEffectRun = 0;
     bool autoSwitch = true;
+    uint16_t xfadeTime = FX_CROSSFADE_MS;   //duration of the crossfade between effects, ms; 0 when effects wind down instead
+    ulong nextFrame = 0;            //time (ms) the next frame of the current effect is due
+    ulong lastRender = 0;           //time (ms) the current effect was last asked to render a frame
+    uint32_t missedFrames = 0;      //number of frames (all effects) that overran into the next frame's scheduled time
+
+    void scheduleNextFrame(LedEffect *fx, EffectState ranState);
 public:
     EffectRegistry() : effects() {};
 
@@ -223,6 +298,12 @@ public:
     void autoRoll(bool switchType = true);
 
     bool isAutoRoll() const;
+
+    void crossfade(uint16_t ms);
+
+    uint16_t crossfadeTime() const;
+
+    uint32_t missedFrameCount() const;
 };
 
 extern EffectRegistry fxRegistry;
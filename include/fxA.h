@@ -6,6 +6,8 @@
 
 #include "efx_setup.h"
 
+#define SLEEPLIGHT_FADE_STEP    22      //16 bit channel decrement per frame while fading to sleep - an 8 bit step every ~12 frames, without the stepping
+
 namespace FxA {
 
     class SleepLight : public LedEffect {
@@ -14,22 +16,26 @@ namespace FxA {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         void windDownPrep() override;
 
         uint8_t selectionWeight() const override;
 
+        uint16_t frameBudget() const override;
+
         ~SleepLight() override = default;
 
     protected:
         enum SleepLightState:uint8_t {Fade, FadeColorTransition, SleepTransition, Sleep} state;
         CHSV colorBuf{};
-        uint8_t timer{};
-        CRGB* const refPixel;   //reference pixel - a pixel guaranteed to be lit/on at all times for this effect
-        std::deque<CRGBSet> slOffSegs;
+        CRGB16 litClr{};        //color of the pixels that stay lit - the whole strip until going to sleep
+        CRGB16 offClr{};        //color of the pixels turned off when going to sleep
+        std::deque<Viewport> slOffSegs;     //pixel ranges turned off when going to sleep
 
+        void layoutSegments();
         SleepLightState step();
+        void render(RenderContext &ctx) const;
     };
 
     class Quiet : public LedEffect {
@@ -38,7 +44,7 @@ namespace FxA {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         void windDownPrep() override;
 
@@ -9,13 +9,13 @@
 namespace FxB {
     void fadein();
 
-    void rainbow();
+    void rainbow(RenderContext &ctx);
 
-    void rainbowWithGlitter();
+    void rainbowWithGlitter(RenderContext &ctx);
 
-    void addGlitter(fract8 chanceOfGlitter);
+    void addGlitter(RenderContext &ctx, fract8 chanceOfGlitter);
 
-    void fxb_confetti();
+    void fxb_confetti(RenderContext &ctx);
 
     void sinelon();
 
@@ -34,11 +34,13 @@ namespace FxB {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         JsonObject & describeConfig(JsonArray &json) const override;
 
         uint8_t selectionWeight() const override;
+
+        uint16_t frameBudget() const override;
     };
 
     class FxB2 : public LedEffect {
@@ -47,9 +49,11 @@ namespace FxB {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         uint8_t selectionWeight() const override;
+
+        uint16_t frameBudget() const override;
     };
 
     class FxB3 : public LedEffect {
@@ -58,11 +62,17 @@ namespace FxB {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
+
+        void windDownPrep() override;
+
+        void nextState() override;
 
         JsonObject & describeConfig(JsonArray &json) const override;
 
         uint8_t selectionWeight() const override;
+
+        uint16_t frameBudget() const override;
     };
 }
 
@@ -9,22 +9,24 @@
 namespace FxC {
     class FxC1 : public LedEffect {
     private:
-        CRGBSet setA, setB;
+        int8_t layerA = -1;     //compositor layer animation A renders into
 
     public:
         FxC1();
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         bool windDown() override;
 
-        void animationA();
+        void animationA(RenderContext &ctx);
 
-        void animationB();
+        void animationB(RenderContext &ctx);
 
         uint8_t selectionWeight() const override;
+
+        uint16_t frameBudget() const override;
     };
 
     class FxC2 : public LedEffect {
@@ -33,11 +35,13 @@ namespace FxC {
 
         //void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         void windDownPrep() override;
 
         uint8_t selectionWeight() const override;
+
+        uint16_t frameBudget() const override;
     };
 }
 #endif //TEEN_LIGHTFX_FXC_H
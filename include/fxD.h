@@ -13,14 +13,16 @@ namespace FxD {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         void windDownPrep() override;
 
-        void plasma();
+        void plasma(RenderContext &ctx);
 
         uint8_t selectionWeight() const override;
 
+        uint16_t frameBudget() const override;
+
     protected:
         uint8_t monoColor;
     };
@@ -31,15 +33,17 @@ namespace FxD {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         bool windDown() override;
 
-        void rainbow_march();
+        void rainbow_march(RenderContext &ctx);
 
         void update_params(uint8_t slot);
 
         uint8_t selectionWeight() const override;
+
+        uint16_t frameBudget() const override;
     };
 
     struct ripple {
@@ -48,12 +52,11 @@ namespace FxD {
         uint16_t center;
         uint8_t rpFade;   // low value - slow fade to black
         uint8_t step;
-        CRGBSet *pSeg;
 
-        void Move();
-        void Fade() const;
+        void Move(CRGBSet &seg, const CRGBPalette16 &pal);
+        void Fade(CRGBSet &seg) const;
         bool Alive() const;
-        void Init(CRGBSet *set);
+        void Init(const CRGBSet &seg);
 
     };
 
@@ -65,11 +68,11 @@ namespace FxD {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         void windDownPrep() override;
 
-        void ripples();
+        void ripples(RenderContext &ctx);
 
         uint8_t selectionWeight() const override;
 
@@ -13,14 +13,16 @@ namespace FxE {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         void windDownPrep() override;
 
-        void serendipitous();
+        void serendipitous(RenderContext &ctx);
 
         uint8_t selectionWeight() const override;
 
+        uint16_t frameBudget() const override;
+
     protected:
         uint16_t Xorig = 0x012;
         uint16_t Yorig = 0x015;
@@ -5,6 +5,11 @@
 #define TEEN_LIGHTFX_FXF_H
 
 #include "efx_setup.h"
+#include "particles.h"
+
+#define FXF5_FLARE_SPARKS   3
+#define FXF5_MAX_SPARKS     (FRAME_SIZE/3)  //the explosion has a spark for every 3 pixels of flare height; the flare goes up to 80% of the frame
+#define FXF5_EXPLODE_STEPS  540
 
 namespace FxF {
     class FxF1 : public LedEffect {
@@ -13,48 +18,55 @@ namespace FxF {
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         bool windDown() override;
 
         uint8_t selectionWeight() const override;
-    };
 
-    struct Spark {
-        float pos=0;
-        float velocity=0;
-        uint8_t hue=0;
-
-        inline uint16_t iPos() const {
-            return uint16_t(abs(pos));
-        }
-        inline float limitPos(float limit) {
-            return pos = constrain(pos, 0, limit);
-        }
+        uint16_t frameBudget() const override;
     };
 
+    typedef Particle Spark;
+
     class FxF5 : public LedEffect {
     public:
         explicit FxF5();
 
         void setup() override;
 
-        void run() override;
+        bool run(RenderContext &ctx) override;
 
         bool windDown() override;
 
         uint8_t selectionWeight() const override;
 
+        uint16_t frameBudget() const override;
+
     protected:
-        //Spark sparks[NUM_SPARKS]{};
-        float flarePos{};
+        enum FireworksStage:uint8_t {Launch, Flare, Explode};
+        FireworksStage stage = Launch;
+        ulong nextLaunch = 0;           //time (ms) the next flare is sent up
+        Spark flareSparks[FXF5_FLARE_SPARKS]{};
+        Spark sparks[FXF5_MAX_SPARKS]{};
+        ushort nSparks = 0;             //number of sparks in use for the current explosion
+        ushort explodeIter = 0;
+        bool activeSparks = false;
+        fix16 flarePos{};
+        fix16 flareStep{};
+        fix16 flareVel{};
+        fix16 flBrightness{};
+        DecayingFix16 dyingGravity{};
+        uint8_t decayHue = 0;
         bool bFade = false;
-        const float gravity = -.004;    // m/s/s
+        const fix16 gravity = TO_FIX16(-.004f);    // m/s/s
         const ushort explRangeLow = 3;  //30%
         const ushort explRangeHigh = 8; //80%
 
-        void flare();
-        void explode() const;
+        void flarePrep(const RenderContext &ctx);
+        bool flare(RenderContext &ctx);
+        void explodePrep(const RenderContext &ctx);
+        bool explode(RenderContext &ctx);
     };
 }
 #endif //TEEN_LIGHTFX_FXF_H
@@ -0,0 +1,76 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_FXBENCH_H
+#define TEEN_LIGHTFX_FXBENCH_H
+
+#ifdef FX_BENCHMARK
+
+#include "efx_setup.h"
+
+#define BENCH_FRAMES_PER_FX     100     //number of frames each effect renders off-screen
+#define BENCH_MAX_MS_PER_FX     15000   //upper limit of time spent with one effect - for effects that render rarely (e.g. Quiet)
+#define BENCH_STACK_PROBE_SIZE  4096    //bytes of stack below the benchmark frame painted for peak stack usage detection
+#define BENCH_THREAD_STACK_SIZE 8192    //benchmark thread stack size - must exceed the probe size with room to spare
+#define BENCH_PARTICLES         64      //number of particles in the physics kernels comparison
+#define BENCH_PARTICLE_STEPS    500     //number of frames the particle physics are stepped for
+#define BENCH_EASE_RANGE        1000    //easing functions are evaluated over [0, BENCH_EASE_RANGE] - one call per value
+#define BENCH_REPLICATE_ROUNDS  50      //number of times the template is replicated over the rest of the strip
+#define BENCH_DITHER_ROUNDS     50      //number of times a frame is dithered, for each strip size
+#define BENCH_SHIFT_ROUNDS      200     //number of single pixel shifts of the whole strip, for each strip size - one wipe transition's worth
+#define BENCH_CROSSFADE_ROUNDS  50      //number of times two frames are crossfaded, for each strip size
+
+/**
+ * LED controller standing in for the WS2811 strip in benchmark builds - records the frames pushed through <code>FastLED.show()</code>
+ * instead of shifting them out on the data pin
+ */
+class BenchLedSink : public CPixelLEDController<RGB> {
+public:
+    uint32_t frames = 0;        //number of frames pushed so far
+    uint32_t checksum = 5381;   //running hash of all the pixel data pushed - allows comparing rendering output across builds; the dithered pushes depend on timing
+
+protected:
+    void init() override {}
+    void showPixels(PixelController<RGB> &pixels) override;
+};
+
+/**
+ * Outcome of running one effect through the benchmark
+ */
+struct FxBenchResult {
+    uint32_t frames;        //frames rendered
+    uint64_t totalTime;     //total time spent rendering the frames above, in ns
+    uint32_t maxFrameTime;  //longest frame, in ns
+    int32_t heapDelta;      //heap bytes allocated (and not released) while running the effect
+    uint32_t allocations;   //number of allocations made while running the effect
+    uint16_t peakStack;     //peak stack used by the effect, in bytes
+};
+
+extern BenchLedSink benchSink;
+
+void bench_setup();
+void bench_run();
+bool benchLayout(uint16_t pixels);
+FxBenchResult benchEffect(LedEffect *fx, uint16_t frames = BENCH_FRAMES_PER_FX);
+bool benchWithinBudget(const LedEffect *fx, const FxBenchResult &res);
+
+/**
+ * Calls a function for each distinct registered effect, in registration order - some effects register themselves twice, back to back,
+ * and are visited once
+ * @tparam F callable taking a <code>LedEffect *</code>
+ * @param fn function to call for each effect
+ */
+template<typename F> void benchForEachEffect(F &&fn) {
+    const LedEffect *prevFx = nullptr;
+    for (uint16_t x = 0; x < fxRegistry.size(); x++) {
+        LedEffect *fx = fxRegistry.getEffect(x);
+        if (fx == prevFx)
+            continue;
+        prevFx = fx;
+        fn(fx);
+    }
+}
+
+#endif //FX_BENCHMARK
+
+#endif //TEEN_LIGHTFX_FXBENCH_H
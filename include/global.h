@@ -21,6 +21,8 @@
 
 #define LED_EFFECT_ID_SIZE  6
 #define MAX_EFFECTS_HISTORY 20
+#define TRANSITION_FRAME_TIME   10      //frame period (ms) the effects are stepped at while winding down or transitioning - the transitions pace themselves within
+#define FX_CROSSFADE_MS     0       //default duration (ms) of the fade from the outgoing effect's last frame, opt-in; 0 - effects wind down and pause in between
 #define AUDIO_HIST_BINS_COUNT   10
 #define FX_SLEEPLIGHT_ID    "FXA1"
 #define FX_QUIET_ID         "FXA2"
@@ -37,12 +39,13 @@ extern const char csCurFx[];
 extern const uint8_t dimmed;
 //extern const uint16_t FRAME_SIZE;
 extern const CRGB BKG;
-extern const uint8_t maxChanges;
+extern const uint16_t paletteBlendTime;
 extern const uint8_t minBrightness;
 enum OpMode { TurnOff, Chase };
 enum EffectState {Setup, Running, WindDownPrep, WindDown, TransitionBreakPrep, TransitionBreak, Idle};
-extern CRGB leds[NUM_PIXELS];
-extern CRGBArray<NUM_PIXELS> frame;
+extern uint16_t numPixels;                  //active number of pixels on the strip - see readLayout in pixelmap.h
+extern CRGB leds[MAX_NUM_PIXELS];
+extern CRGBArray<MAX_NUM_PIXELS> frame;
 extern CRGBSet ledSet;
 extern CRGBSet segUp;
 extern CRGBSet segRight;
@@ -51,9 +54,9 @@ extern CRGBSet segLeft;
 extern CRGBSet segBack;
 extern CRGBSet tpl;
 extern CRGBSet others;
-extern uint16_t stripShuffleIndex[NUM_PIXELS];
-extern CRGBPalette16 palette;
-extern CRGBPalette16 targetPalette;
+extern uint16_t stripShuffleIndex[MAX_NUM_PIXELS];
+extern const CRGBPalette16 &palette;         //owned by paletteBlender - see PaletteFactory.h
+extern const CRGBPalette16 &targetPalette;   //owned by paletteBlender - see PaletteFactory.h
 extern OpMode mode;
 extern uint8_t brightness;
 extern uint8_t stripBrightness;
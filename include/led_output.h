@@ -0,0 +1,215 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_LED_OUTPUT_H
+#define TEEN_LIGHTFX_LED_OUTPUT_H
+
+#include <Arduino.h>
+#include "global.h"
+#include "util.h"
+#include "pixelmap.h"
+
+#define MAX_LED_OUTPUTS     4       //max number of data lines - FastLED's RP2040 driver takes one PIO state machine per line, PDM2040 takes one more
+#define WIRE_BIT_TIME_NS    1250    //WS2811 bit period in high speed (800kHz) mode - 24 bits per pixel
+#define WIRE_RESET_US       50      //WS2811 reset (latch) time at the end of a frame
+#define DITHER_MAX_BRIGHTNESS   64      //frames shown at this brightness or lower are temporally dithered - through the gamma curve, most of their intensities fall under 8 bit resolution
+#define DITHER_FRAME_TIME_US    10000   //while dithering, the last frame is dithered and pushed again this often until a new frame comes in - 100 FPS
+#define DITHER_SETTLE_FRAMES    256     //number of times a frame is dithered and pushed before it settles - a whole cycle of any 8 bit residual
+#define FRAME_DITHER        0x02    //flag of the frame hand-over message - the frame is to be dithered
+#define FRAME_PENDING       0x80    //flag of the frame hand-over message - a frame has been handed over and not picked up yet
+#define CROSSFADE_CURVE     EaseInOutSine   //easing of the crossfade between effects - weight of the incoming effect's frames over time
+
+/**
+ * Aggregate statistics of the last frame pushed to the strip - as rendered by the effect, before the output curve. A pixel is lit when its
+ * luma is above black's, the same test <code>isAnyLedOn</code> uses
+ */
+struct FrameStats {
+    uint16_t litPixels;             //number of lit pixels
+    uint8_t maxLuma;                //luma of the brightest pixel
+    uint32_t totalLuma;             //sum of the pixels' luma
+    uint16_t segmentLit[SEG_COUNT]; //number of lit pixels in each room segment
+};
+
+/**
+ * Pixel with 16 bit channels, in 8.8 fixed point - the high byte is the 8 bit color value, the low byte the fraction below it
+ */
+struct CRGB16 {
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+
+    CRGB16() = default;
+    constexpr CRGB16(uint16_t red, uint16_t green, uint16_t blue) : r(red), g(green), b(blue) {}
+    explicit constexpr CRGB16(const CRGB &c) : r(c.r << 8), g(c.g << 8), b(c.b << 8) {}
+
+    inline CRGB toCRGB() const {
+        return {(uint8_t)(r >> 8), (uint8_t)(g >> 8), (uint8_t)(b >> 8)};
+    }
+
+    inline bool isBlack() const {
+        return (r | g | b) == 0;
+    }
+};
+
+/**
+ * Physical data line driving a contiguous range of the strip
+ */
+struct LedOutput {
+    uint8_t pin;        //data pin
+    uint16_t start;     //first pixel of the strip driven by this output
+    uint16_t size;      //number of pixels driven by this output
+};
+
+/**
+ * Rotating-origin view of a pixel buffer - logical pixel 0 is at physical index <code>origin()</code> and the logical pixels wrap around
+ * the end of the buffer. Shifting or rotating the whole view moves the origin rather than the pixels; only the pixels fed in are written.
+ * <p>The physical order is restored either explicitly (<code>linearize</code>) or, for the strip's pixel buffer (<code>ledRing</code>), by
+ * the output stage as it copies the frame through the output curve</p>
+ */
+class RingSet {
+public:
+    RingSet(CRGB *pixels, uint16_t szPixels);
+    inline CRGB &operator[](uint16_t index) {
+        const uint16_t x = head + index;
+        return pixels[x < sz ? x : x - sz];
+    }
+    uint16_t size() const;
+    uint16_t origin() const;
+    CRGB *data();
+    void fill(uint16_t from, uint16_t count, const CRGB &color);
+    void rotateRight(uint16_t pos);
+    void rotateLeft(uint16_t pos);
+    void shiftRight(const CRGB &feedLeft, uint16_t pos);
+    void shiftLeft(const CRGB &feedRight, uint16_t pos);
+    void linearize();
+
+protected:
+    CRGB *pixels;   //physical buffer
+    uint16_t sz;    //number of pixels in the view
+    uint16_t head;  //physical index of the logical pixel 0
+};
+
+/**
+ * Output stage of the LED strip - the single path from the effects' pixel buffer (<code>leds</code>) to the strip.
+ * Effects and transitions push their frames through <code>show</code> rather than calling <code>FastLED.show()</code> directly.
+ * <p>The strip is double buffered: effects render into <code>leds</code> (back buffer) on the fx thread, while the second RP2040 core
+ * shifts the previous frame out to the strip. A completed frame is copied into a front buffer at frame boundary and handed over to the second
+ * core, which converts it into the wire buffer - the FastLED controllers are registered with the wire buffer. There are two front buffers,
+ * used alternately: one is being written while the second core works from the other. The frames are handed over through a shared word
+ * rather than the inter-core FIFO - the FIFO carries the flash lockout requests (see <code>writeTextFile</code>): the second core runs
+ * from RAM and is paused while the first core writes to flash.</p>
+ * <p>Frames identical to the last one pushed (same pixels, same brightness) are not sent on the wire again - a hash of the pixel buffer
+ * is compared with the previous frame's</p>
+ * <p>Effects that render only a template (typically <code>tpl</code>, at the start of the strip) repeated over the entire strip can engage the
+ * template mode - see <code>setTemplate</code>. The output stage then expands the template into the front buffer in whole blocks, and the
+ * effect does not replicate the template into <code>leds</code> anymore.</p>
+ * <p>The strip can be split across several data lines (outputs) - see LED_OUTPUTS in config.h. Each output has its own FastLED controller
+ * registered with its range of the wire buffer, hence the lines shift out concurrently and a frame's wire time is that of the longest output</p>
+ * <p>Color correction (white balance), color temperature, gamma and brightness are all applied here, through a per-channel lookup table
+ * combining them - as the frame is copied into the front buffer. The table is rebuilt only when one of these parameters changes; the FastLED
+ * controllers are registered uncorrected and shift the wire buffer out as is. Channel values and brightness are both perceptual: the brightness
+ * goes through the gamma curve as well, such that the effects need no brightness curves of their own (e.g. <code>dim8_raw</code>)</p>
+ * <p>The output curve yields 16 bit channels (8.8 fixed point) - the front buffers are handed over to the second core at this precision.
+ * Frames shown at low brightness (see DITHER_MAX_BRIGHTNESS) are temporally dithered into the wire buffer: each channel's fraction is
+ * carried over to the next frame (error diffusion over time), and the second core keeps dithering and pushing the last frame at 100 FPS until
+ * the next one comes in - the fraction averages out on the strip as intermediate intensities, rather than 8 bit steps. A frame left unchanged
+ * settles after <code>DITHER_SETTLE_FRAMES</code> pushes: it is pushed once more, rounded, and held. Frames shown above that brightness are
+ * rounded and pushed once, as are the frames skipped for being identical with the last one.</p>
+ * <p>The current drawn by each frame is estimated as it goes through the output curve (sum of channel values weighted by each channel's
+ * current at full intensity) - a frame estimated above the power budget is dimmed to fit it before being handed over to the second core.
+ * The same pass collects the frame's statistics (lit pixels, luma) - see <code>frameStats</code></p>
+ * <p>Effects that need the extra precision at the source (e.g. slow fades at low intensity) can render into the 16 bit pixel buffer instead
+ * of <code>leds</code> - see <code>setHighRes</code>. Frames rendered in high resolution are always dithered</p>
+ * <p>Effect changes can crossfade - see <code>crossfade</code>: the frame last pushed is held and blended, with an easing curve, under the
+ * frames that follow until the crossfade time has elapsed. Frames are pushed while crossfading even if the pixel buffer has not changed. The
+ * frame held shares its buffer with the high resolution mode: effects rendering in high resolution are not crossfaded into</p>
+ * <p>Buffers are statically sized for <code>MAX_NUM_PIXELS</code>: 6 bytes per pixel for each front buffer and the shared 16 bit buffer, 3 for
+ * the wire buffer and the dithering residual - 24KB at 1024 pixels. Each output shifts 30us of wire time per pixel: a frame must fit the 10ms
+ * dithering frame time (<code>DITHER_FRAME_TIME_US</code>) for the dithering to run at 100 FPS, which takes about 320 pixels per output at most.
+ * 1024 pixels on a single output take 31ms on the wire - their dimmed and high resolution frames dither at 32 FPS, with visible flicker; such
+ * strips need LED_OUTPUTS 4</p>
+ * <p>The pixel buffer may be rotated - shifts of the entire strip (e.g. wipe transitions) move the origin of <code>ledRing</code> rather than
+ * the pixels. The frame is linearized from the ring's origin as it is copied through the output curve; the template and high resolution modes
+ * linearize the pixel buffer before engaging, as does clearing the strip</p>
+ */
+class StripOutput {
+public:
+    void begin();
+    void show();
+    void show(uint8_t bright);
+    void clear();
+    void invalidate();
+    void setTemplate(uint16_t szTemplate);
+    uint16_t templateSize() const;
+    void setHighRes(bool on);
+    bool isHighRes() const;
+    CRGB16 *highResBuffer();
+    CRGB *wireBuffer();
+    uint32_t frameCount() const;
+    uint32_t skippedCount() const;
+    const TimingStats &showTiming() const;
+    void mapOutputs();
+    uint8_t outputCount() const;
+    const LedOutput &output(uint8_t index) const;
+    uint32_t frameWireTime() const;
+    static uint32_t wireTime(uint16_t pixels);
+    void setCorrection(const CRGB &corr);
+    void setTemperature(const CRGB &temp);
+    void setGamma(float gamma);
+    static void ditherFrame(CRGB *dest, const CRGB16 *src, uint8_t *residual, uint16_t szPixels);
+    void setPowerBudget(uint16_t mA);
+    uint16_t powerBudget() const;
+    uint32_t powerEstimate() const;
+    bool isPowerLimited() const;
+    uint32_t powerLimitedCount() const;
+    const FrameStats &frameStats() const;
+    void crossfade(uint16_t ms);
+    bool isCrossfading() const;
+    static void crossfadeFrame(CRGB16 *dest, const CRGB16 *from, uint16_t szPixels, fract16 amount, uint32_t *sums);
+
+protected:
+    CRGB16 buf16[MAX_NUM_PIXELS] {};        //16 bit pixel buffer shared by the high resolution mode and the crossfade - never in use by both
+    CRGB16 *const back16 = buf16;           //pixel buffer the effects render into in high resolution mode
+    CRGB16 front[2][MAX_NUM_PIXELS] {};     //frames handed over to the second core, through the output curve - alternating
+    CRGB wire[MAX_NUM_PIXELS] {};           //frame being shifted out to the strip - owned by the second core
+    uint8_t residual[MAX_NUM_PIXELS*3] {};  //dithering residual of each channel - the fraction carried over to the next frame; second core
+    volatile uint32_t handoff = 0;  //frame hand-over message - FRAME_PENDING set until the second core picks the frame up
+    uint8_t nextFront = 0;      //front buffer the next frame is written into - the other one may be in use by the second core
+    bool highRes = false;       //whether the effect renders into the 16 bit pixel buffer
+    uint32_t frames = 0;        //number of frames submitted for display
+    uint32_t skipped = 0;       //number of frames submitted that were identical with the strip's content, hence not pushed
+    uint32_t lastHash = 0;      //hash of the last frame pushed to the strip
+    bool forcePush = true;      //whether next frame must be pushed regardless of its hash
+    uint16_t tplSize = 0;       //size of the template repeated over the strip; 0 when template mode is off
+    TimingStats showStats;      //how long FastLED.show() takes to shift a frame out - measured on the second core
+    LedOutput outputs[LED_OUTPUTS] {};  //strip ranges of the data lines
+    uint16_t lut[3][256] {};    //per channel output curve, 8.8 fixed point - gamma, correction, temperature and brightness combined
+    uint16_t gammaCurve[256] {};    //gamma curve of the output, 8.8 fixed point - identity when gamma is 1.0; brightness goes through it as well
+    CRGB correction {OUTPUT_CORRECTION};    //white balance of the strip's LEDs
+    CRGB temperature {OUTPUT_TEMPERATURE};  //color temperature
+    uint8_t lutBright = 0;      //brightness the lookup table was built for
+    bool lutDirty = true;       //whether the lookup table needs rebuilding - a curve parameter has changed
+    uint16_t budget = POWER_BUDGET_MA;  //max current the strip may draw, in mA
+    uint32_t powerDraw = 0;     //estimated current drawn by the last frame pushed, in mA - after limiting
+    uint32_t limitedFrames = 0; //number of frames dimmed to fit the power budget
+    bool limited = false;       //whether the last frame pushed has been dimmed to fit the power budget
+    FrameStats stats {};        //statistics of the last frame pushed
+    CRGB16 *const fadeFrom = buf16;         //frame being crossfaded out - as pushed, through the output curve
+    ulong fadeStart = 0;        //time (ms) the crossfade started at
+    uint16_t fadeTime = 0;      //duration of the crossfade in progress, in ms; 0 when not crossfading
+
+    void buildLut(uint8_t bright);
+    void applyLut(CRGB16 *dest, const CRGB *src, uint16_t szPixels, uint16_t origin, uint32_t *sums, FrameStats &st) const;
+    void applyLut(CRGB16 *dest, const CRGB16 *src, uint16_t szPixels, uint32_t *sums, FrameStats &st) const;
+    void limitPower(CRGB16 *frame, const uint32_t *sums);
+
+    template<typename T> void expandTemplate(T *dest) const;
+    static uint32_t frameHash(const void *pixels, uint32_t szBytes, uint32_t seed);
+    static bool pickFrame(uint32_t timeout, uint32_t &msg);
+    [[noreturn]] static void pushLoop();
+};
+
+extern StripOutput stripOutput;
+extern RingSet ledRing;
+
+#endif //TEEN_LIGHTFX_LED_OUTPUT_H
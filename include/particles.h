@@ -0,0 +1,98 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_PARTICLES_H
+#define TEEN_LIGHTFX_PARTICLES_H
+
+#include <Arduino.h>
+
+/**
+ * Signed fixed point number in Q16.16 format - 16 bits integer part, 16 bits fractional part.
+ * <p>The RP2040 Cortex-M0+ has no FPU, every float operation is a software library call. The particle physics use fixed point math instead.</p>
+ */
+typedef int32_t fix16;
+
+#define FIX16_ONE       ((fix16)0x00010000)
+#define FIX16_HALF      ((fix16)0x00008000)
+//decay factors are unsigned Q0.16 fractions - FIX16_DECAY(0.985f) scales a value down by 1.5% - evaluated at compile time for literals
+#define FIX16_DECAY(f)  ((uint16_t)((f) * 65536.0f + 0.5f))
+#define TO_FIX16(f)     ((fix16)((f) * 65536.0f + ((f) < 0 ? -0.5f : 0.5f)))
+
+inline fix16 toFix16(int16_t x) {
+    return (fix16)x * FIX16_ONE;
+}
+
+inline int16_t fix16ToInt(fix16 x) {
+    return (int16_t)(x >> 16);
+}
+
+/**
+ * Fraction of two integers as fixed point number
+ * @param num numerator
+ * @param den denominator, must not be 0
+ * @return num/den in Q16.16
+ */
+inline fix16 fix16Ratio(int32_t num, int32_t den) {
+    return (fix16)(((int64_t)num << 16) / den);
+}
+
+inline fix16 fix16Mul(fix16 a, fix16 b) {
+    return (fix16)(((int64_t)a * b) >> 16);
+}
+
+/**
+ * Scales a fixed point number by a decay factor
+ * @param x value to scale
+ * @param decay Q0.16 factor - see <code>FIX16_DECAY</code>
+ * @return x*decay
+ */
+inline fix16 fix16Decay(fix16 x, uint16_t decay) {
+    return (fix16)(((int64_t)x * decay) >> 16);
+}
+
+inline fix16 fix16Abs(fix16 x) {
+    return x < 0 ? -x : x;
+}
+
+/**
+ * Fixed point value decaying frame over frame by a constant factor (e.g. the gravity of burning out sparks) - kept with 32 fractional bits.
+ * In Q16.16 the rounding of each decay step adds up over hundreds of frames, and a small negative value stalls where the rounding down
+ * cancels the decay
+ */
+struct DecayingFix16 {
+    int64_t q32 = 0;    //value in Q32.32
+
+    DecayingFix16() = default;
+    explicit DecayingFix16(fix16 x) : q32((int64_t)x << 16) {}
+
+    /**
+     * Scales the value by a decay factor, rounding towards zero
+     * @param decay Q0.16 factor - see <code>FIX16_DECAY</code>
+     */
+    inline void decay(uint16_t decay) {
+        q32 = q32 < 0 ? -((-q32 * decay) >> 16) : (q32 * decay) >> 16;
+    }
+    inline fix16 value() const {
+        return (fix16)((q32 + FIX16_HALF) >> 16);
+    }
+};
+
+/**
+ * One particle of a 1D particle system - position along the strip and velocity, in pixels and pixels/frame respectively
+ */
+struct Particle {
+    fix16 pos = 0;
+    fix16 velocity = 0;
+    uint8_t hue = 0;
+
+    inline uint16_t iPos() const {
+        return (uint16_t)fix16ToInt(fix16Abs(pos));
+    }
+    inline fix16 limitPos(fix16 limit) {
+        return pos = pos < 0 ? 0 : (pos > limit ? limit : pos);
+    }
+};
+
+uint16_t particlesStep(Particle *particles, uint16_t count, fix16 gravity, fix16 limit);
+
+#endif //TEEN_LIGHTFX_PARTICLES_H
@@ -86,8 +86,8 @@ function getStatus() {
             let hdlst = $('#holidayList');
             hdlst.val(data.fx.holiday);
             hdlst.attr("currentColorTheme", data.fx.holiday);
-            //approximately undo the dimming rules in FastLED library where dimming raw is equivalent with x*x/256
-            let brPerc = Math.round(Math.sqrt(data.fx.brightness * 256)*100/256);
+            //brightness is perceptual - the board's output curve applies the gamma
+            let brPerc = Math.round(data.fx.brightness*100/255);
             $('#fxBrightness').html(`${brPerc}% (${data.fx.brightness}${data.fx.brightnessLocked?' fixed':' auto'})`)
             let brList = $('#brightList');
             brList.val(brPerc);
@@ -180,10 +180,7 @@ function updateBrightness() {
     let brlst = $('#brightList');
     let selBr = brlst.val();
     let request = {};
-    request["brightness"] = Math.round(Math.pow(selBr*256/100, 2)/256);
-    //cap it at 0xFF (1 byte)
-    if (request["brightness"] > 255)
-        request["brightness"] = 255;
+    request["brightness"] = Math.round(selBr*255/100);
     $.ajax({
         type: "PUT",
         url: "/fx",
@@ -193,7 +190,7 @@ function updateBrightness() {
         success: function (response) {
             $('#updateStatus').html("Strip brightness update successful").removeClass().addClass("status-ok");
             brlst.attr("currentBrightness", selBr);
-            let brPerc = Math.round(Math.sqrt(response.updates.brightness * 256)*100/256);
+            let brPerc = Math.round(response.updates.brightness*100/255);
             $('#fxBrightness').html(`${brPerc}% (${response.updates.brightness}${response.updates.brightnessLocked?' fixed':' auto'})`);
             scheduleClearStatus();
         },
@@ -0,0 +1,124 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_PIXELMAP_H
+#define TEEN_LIGHTFX_PIXELMAP_H
+
+#include <Arduino.h>
+#include "global.h"
+
+// Orientation of the segments - a segment is reversed when its pixel indexes decrease in the direction of travel (up the pole, clockwise
+// around the ceiling perimeter). Boards wired differently override these in their config.h block
+#ifndef SEG_UP_REVERSED
+#define SEG_UP_REVERSED     false
+#endif
+#ifndef SEG_RIGHT_REVERSED
+#define SEG_RIGHT_REVERSED  false
+#endif
+#ifndef SEG_FRONT_REVERSED
+#define SEG_FRONT_REVERSED  false
+#endif
+#ifndef SEG_LEFT_REVERSED
+#define SEG_LEFT_REVERSED   false
+#endif
+#ifndef SEG_BACK_REVERSED
+#define SEG_BACK_REVERSED   false
+#endif
+
+#define SEG_COUNT           5       //number of room segments in the layout
+#define MIN_SEGMENT_SIZE    10      //smallest segment supported - SleepLight leaves the corners and the middle of each wall dark
+#define MIN_NUM_PIXELS      (SEG_COUNT*MIN_SEGMENT_SIZE)    //smallest strip supported - every segment at its smallest; the template shrinks to the strip
+#define LAYOUT_JSON_DOC_SIZE    512
+
+/**
+ * Room segments, in the order they appear in the layout. Right, Front, Left and Back form the ceiling perimeter loop, in this order
+ */
+enum SegmentId:uint8_t {SegUp, SegRight, SegFront, SegLeft, SegBack};
+
+/**
+ * Describes one segment of the room layout
+ */
+struct SegmentDef {
+    uint16_t start;     //index of the first pixel, inclusive
+    uint16_t end;       //index of the last pixel, inclusive
+    bool reversed;      //whether the pixel indexes decrease in the direction of travel
+    bool perimeter;     //whether the segment is part of the ceiling perimeter loop
+    constexpr uint16_t size() const { return end - start + 1; }
+};
+
+/**
+ * The default room layout of this board - segment boundaries come from the SEG_* defines of the BOARD_ID block in config.h. In effect
+ * unless a valid layout file is found on the filesystem at boot, see <code>readLayout</code>
+ */
+constexpr SegmentDef defaultLayout[SEG_COUNT] = {
+        {SEG_UP_START, SEG_UP_END, SEG_UP_REVERSED, false},
+        {SEG_RIGHT_START, SEG_RIGHT_END, SEG_RIGHT_REVERSED, true},
+        {SEG_FRONT_START, SEG_FRONT_END, SEG_FRONT_REVERSED, true},
+        {SEG_LEFT_START, SEG_LEFT_END, SEG_LEFT_REVERSED, true},
+        {SEG_BACK_START, NUM_PIXELS-1, SEG_BACK_REVERSED, true},
+};
+
+/**
+ * Geometric map of the strip - places every pixel in a normalized coordinate space, so that effects can render by position rather than by
+ * pixel index. Two coordinates are tracked for each pixel, both normalized to 0..65535 and increasing in the direction of travel:
+ * <ul>
+ *   <li><code>coord</code> - position along the path the pixel belongs to: the ceiling perimeter loop for the perimeter segments, the pole for
+ *   the Up segment</li>
+ *   <li><code>local</code> - position within the pixel's own segment, 0 and 65535 being the segment ends (the room corners for the walls)</li>
+ * </ul>
+ * <p>The tables are computed once at boot from the active layout; the lookups are a table read (and a multiply for the reverse mapping from
+ * perimeter coordinate to pixel), no per-frame index arithmetic</p>
+ */
+class PixelMap {
+public:
+    const SegmentDef *segments = nullptr;
+    uint16_t coord[MAX_NUM_PIXELS] {};      //position of each pixel along its path
+    uint16_t local[MAX_NUM_PIXELS] {};      //position of each pixel within its segment
+    uint8_t segment[MAX_NUM_PIXELS] {};     //segment of each pixel - a SegmentId
+    uint16_t perimeter[MAX_NUM_PIXELS] {};  //pixel indexes of the perimeter loop, in the direction of travel
+    uint16_t perimeterSize = 0;             //number of pixels in the perimeter loop
+
+    void build(const SegmentDef *segs, uint8_t count);
+
+    /**
+     * Pixel at a given position along the ceiling perimeter loop
+     * @param pos normalized position along the perimeter, 0..65535
+     * @return index of the physical pixel at that position
+     */
+    inline uint16_t perimeterPixel(uint16_t pos) const {
+        return perimeter[((uint32_t)pos * perimeterSize) >> 16];
+    }
+
+    /**
+     * Mirror image of a pixel within its own segment - the pixel at the same distance from the other end of the segment (wall)
+     * @param px pixel index
+     * @return index of the mirrored pixel
+     */
+    inline uint16_t mirror(uint16_t px) const {
+        const SegmentDef &s = segments[segment[px]];
+        return s.start + s.end - px;
+    }
+
+    /**
+     * Distance of a pixel to the nearest end of its segment - for the walls, the distance to the nearest room corner. Pixels equally far
+     * from a corner on either side of it have the same value, which makes for corner symmetric effects
+     * @param px pixel index
+     * @return distance to the nearest segment end, normalized to 0 (at the end) .. 65534 (middle of the segment)
+     */
+    inline uint16_t cornerDistance(uint16_t px) const {
+        uint16_t l = local[px];
+        return l < 0x8000 ? l << 1 : (0xFFFF - l) << 1;
+    }
+
+    inline const SegmentDef &segmentOf(uint16_t px) const {
+        return segments[segment[px]];
+    }
+};
+
+extern SegmentDef roomLayout[SEG_COUNT];
+extern PixelMap pixelMap;
+
+bool setLayout(const SegmentDef *segs, uint16_t pixels);
+bool readLayout();
+
+#endif //TEEN_LIGHTFX_PIXELMAP_H
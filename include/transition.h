@@ -6,7 +6,6 @@
 
 #include <Arduino.h>
 #include "global.h"
-#include <deque>
 
 #define SELECTOR_SPOTS  0x0100
 #define SELECTOR_WIPE   0x0200
@@ -14,8 +13,25 @@
 #define SELECTOR_RANDOM_BARS    0x0400
 #define SELECTOR_FADE   0x0500
 
+#define TRANSITION_OFF_LEVEL    4       //a fading pixel is turned off once all its channels are below this level
+#define MAX_RANDOM_BARS         (MAX_NUM_PIXELS/3+1)    //random bars are at least 3 pixels long, except the last one
+
+/**
+ * Fade out of one pixel, as planned by a transition - the pixel fades by <code>rate</code> each frame, for <code>frames</code> frames
+ * starting at frame <code>start</code> of the transition, and is turned off after
+ */
+struct FadeStep {
+    uint16_t start;     //transition frame the pixel starts fading at
+    uint8_t rate;       //fade amount applied each frame - see CRGB::fadeToBlackBy
+    uint8_t frames;     //number of frames the pixel fades for; 0 for a pixel already off
+};
+
 /**
  * Class for managing and implementing transitions between effects
+ * <p>Each transition is compiled into a plan on its first frame, from the strip content at that time: the fading transitions plan the
+ * fade start frame and rate of every pixel, the wipes the number of shifts that clear the lit pixels. A transition frame is then a single pass
+ * over the strip, and the transition completes exactly when its plan does. The plan is dropped on completion (or on <code>prepare</code>),
+ * such that running a transition again plans it over the new strip content</p>
  */
 class EffectTransition {
 public:
@@ -36,12 +52,24 @@ protected:
     static const uint8_t effectsCount = 6;  //number of 'offXYZ' methods
     uint sel=0;
     uint8_t prefFx = 0;
-    //offSpots variables
-    uint16_t offSpotShuffleOffset;
-    uint16_t offPosIndex;
-    uint16_t offSpotSegSize;
+    FadeStep plan[MAX_NUM_PIXELS] {};   //fade out plan of each pixel - fading transitions
+    uint16_t step = 0;          //frame of the transition - number of frames run so far into the plan
+    uint16_t planEnd = 0;       //frame the plan completes at - all pixels are off after it
+    uint8_t planKey = 0;        //transition (and variant) the plan has been compiled for; 0 when there is no plan
     //offRandomBars variables
-    std::deque<uint8_t> randomBarSegs;
+    uint8_t barSizes[MAX_RANDOM_BARS] {};
+    uint16_t barCount = 0;
+
+    bool needsPlan(uint8_t effect, bool variant);
+    void planSpots();
+    void planWipe(bool rightDir);
+    void planHalfWipe(bool inward);
+    void planFade();
+    void planSplit(bool outward);
+    void planRandomBars(bool rightDir);
+    void planPixel(uint16_t index, uint16_t start, uint8_t rate, uint8_t frames);
+    bool runPlan();
+    bool endFrame();
 };
 
 extern EffectTransition transEffect;
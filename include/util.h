@@ -17,6 +17,7 @@
 
 
 #define IMU_TEMPERATURE_NOT_AVAILABLE   0.001f
+#define TIMING_SAMPLES  64      //number of most recent measurements retained by TimingStats for percentiles
 
 #define SYS_STATUS_WIFI    0x01
 #define SYS_STATUS_NTP     0x02
@@ -26,6 +27,7 @@
 #define SYS_STATUS_ECC     0x20
 
 extern const char stateFileName[];
+extern const char layoutFileName[];
 
 float boardTemperature(bool bFahrenheit = false);
 float chipTemperature(bool bFahrenheit = false);
@@ -72,5 +74,30 @@ public:
     const_iterator end() const { return this->c.end(); }
 };
 
+/**
+ * Aggregates time measurements in fixed size storage (no heap) - min/avg/max over all measurements recorded, percentiles
+ * over the most recent <code>TIMING_SAMPLES</code> measurements
+ * <p>Measurements are recorded by one thread (or core) and reported by another - the recording is guarded by a sequence lock,
+ * readers take a consistent copy with <code>snapshot</code> before reading more than one value</p>
+ */
+class TimingStats {
+    volatile uint32_t seq = 0;            //sequence lock - odd while a measurement is being recorded
+    uint16_t samples[TIMING_SAMPLES] {};  //ring of most recent measurements in us, saturated at UINT16_MAX
+    uint16_t pos = 0;
+    uint32_t count = 0;
+    uint32_t minTime = UINT32_MAX;
+    uint32_t maxTime = 0;
+    uint64_t totalTime = 0;
+public:
+    void record(uint32_t us);
+    void reset();
+    TimingStats snapshot() const;
+    uint32_t getCount() const;
+    uint32_t getMin() const;
+    uint32_t getMax() const;
+    uint32_t getAverage() const;
+    uint16_t getPercentile(uint8_t pct) const;
+};
+
 extern FixedQueue<TimeSync, 8> timeSyncs;
 #endif //TEEN_LIGHTFX_UTIL_H
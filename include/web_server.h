@@ -16,6 +16,8 @@
 #include "pixel_css.h"
 #include "pixel_js.h"
 
+#define STATUS_JSON_DOC_SIZE    5120    //capacity of the status document - allocated on the heap for each status request
+
 namespace web {
 
     typedef size_t (*reqHandler)(WiFiClient*, String*, String*, String*);
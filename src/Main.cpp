@@ -8,10 +8,15 @@
 #include "log.h"
 #include "net_setup.h"
 #include "FxSchedule.h"
+#include "fxbench.h"
 #include <SchedulerExt.h>
 
+#ifdef FX_BENCHMARK
+ThreadTasks benchTasks {bench_setup, bench_run};
+#else
 ThreadTasks fxTasks {fx_setup, fx_run};
 ThreadTasks micTasks {mic_setup, mic_run};
+#endif
 
 void adc_setup() {
     //disable ADC
@@ -38,8 +43,12 @@ void setup() {
     imu_setup();
     secElement_setup();
 
+#ifdef FX_BENCHMARK
+    Scheduler.startLoop(&benchTasks, BENCH_THREAD_STACK_SIZE);
+#else
     Scheduler.startLoop(&fxTasks, 3072);
     Scheduler.startLoop(&micTasks, 1024);
+#endif
 
     bool bSetupOk = wifi_setup();
     bSetupOk = bSetupOk && time_setup();
@@ -179,4 +179,104 @@ CRGBPalette16 PaletteFactory::randomPalette(uint8_t ofsHue, time_t time) {
             CHSV(ofsHue + random8(), 255, random8(128,255))};
 }
 
-PaletteFactory paletteFactory;
\ No newline at end of file
+// PaletteBlender
+/**
+ * Replaces the current palette - any timed blend in progress continues from the new palette
+ * @param pal new palette
+ */
+void PaletteBlender::setPalette(const CRGBPalette16 &pal) {
+    if (memcmp(cur.entries, pal.entries, sizeof(cur.entries)) == 0)
+        return;
+    cur = pal;
+    curGen++;
+    if (blendDuration > 0)
+        blendOver(blendDuration);
+    checkConverged();
+}
+
+/**
+ * Replaces the target palette - any timed blend in progress is restarted from the current palette toward the new target
+ * @param pal new target palette
+ */
+void PaletteBlender::setTarget(const CRGBPalette16 &pal) {
+    if (memcmp(tgt.entries, pal.entries, sizeof(tgt.entries)) == 0)
+        return;
+    tgt = pal;
+    tgtGen++;
+    if (blendDuration > 0)
+        blendOver(blendDuration);
+    checkConverged();
+}
+
+/**
+ * Starts a timed blend of the current palette toward the target - the target is reached after the given duration, see <code>update</code>
+ * @param durationMs duration of the blend, in ms
+ */
+void PaletteBlender::blendOver(const uint16_t durationMs) {
+    origin = cur;
+    blendStart = millis();
+    blendDuration = durationMs > 0 ? durationMs : 1;
+    blendAmount = 0;
+}
+
+/**
+ * Advances the timed blend in progress, if any, based on the time elapsed since it started - in steps of 1/<code>PALETTE_BLEND_STEPS</code>
+ * of the blend
+ * @return true if the current palette has changed
+ */
+bool PaletteBlender::update() {
+    if (blendDuration == 0)
+        return false;
+    const ulong elapsed = millis() - blendStart;
+    if (elapsed >= blendDuration) {
+        blendDuration = 0;
+        if (memcmp(cur.entries, tgt.entries, sizeof(cur.entries)) == 0)
+            return false;
+        cur = tgt;
+        curGen++;
+        converged = true;
+        return true;
+    }
+    const auto amount = (uint8_t)(elapsed * PALETTE_BLEND_STEPS / blendDuration * (256 / PALETTE_BLEND_STEPS));
+    if (amount == blendAmount)
+        return false;
+    blendAmount = amount;
+    for (uint8_t x = 0; x < 16; x++)
+        cur.entries[x] = blend(origin.entries[x], tgt.entries[x], amount);
+    curGen++;
+    checkConverged();
+    return true;
+}
+
+void PaletteBlender::checkConverged() {
+    converged = memcmp(cur.entries, tgt.entries, sizeof(cur.entries)) == 0;
+}
+
+// PaletteCache
+PaletteCache::PaletteCache(const PaletteBlender &src, const bool target) : blender(src), useTarget(target) {}
+
+/**
+ * Forces the re-expansion of the palette on next lookup
+ */
+void PaletteCache::invalidate() {
+    expanded = false;
+}
+
+/**
+ * Expands the palette colors
+ */
+void PaletteCache::refresh() {
+    const CRGBPalette16 &source = useTarget ? blender.target() : blender.current();
+    expandedGen = useTarget ? blender.targetGeneration() : blender.generation();
+    for (uint16_t x = 0; x < 256; x++)
+        colors[x] = ColorFromPalette(source, x, 255, LINEARBLEND);
+    expanded = true;
+    refreshes++;
+}
+
+PaletteFactory paletteFactory;
+PaletteBlender paletteBlender;
+const CRGBPalette16 &palette = paletteBlender.current();
+const CRGBPalette16 &targetPalette = paletteBlender.target();
+PaletteCache paletteCache(paletteBlender, false);
+PaletteCache targetPaletteCache(paletteBlender, true);
\ No newline at end of file
@@ -0,0 +1,101 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#include "compositor.h"
+#include "efx_setup.h"
+
+Compositor compositor;
+
+/**
+ * Adds a layer on top of the existing ones
+ * @param size number of pixels of the layer - typically the size of the target set it is composited into
+ * @param mode blend mode
+ * @param opacity opacity of the layer - 0 is transparent, 255 is opaque
+ * @return index of the new layer, or -1 if there is no room left in the frame array (or the max number of layers has been reached)
+ */
+int8_t Compositor::addLayer(const uint16_t size, const BlendMode mode, const uint8_t opacity) {
+    if ((layerCount >= MAX_LAYERS) || (size == 0) || (used + size > frame.size()))
+        return -1;
+    layers[layerCount] = {used, size, mode, opacity};
+    used += size;
+    return (int8_t)layerCount++;
+}
+
+/**
+ * Pixels of a layer - effects render into these
+ * @param index layer index, as returned by <code>addLayer</code>
+ * @return the color set backed by the layer's region of the frame array; an empty set if there is no such layer (e.g. the -1
+ * returned by a failed <code>addLayer</code>)
+ */
+CRGBSet Compositor::layer(const uint8_t index) const {
+    if (index >= layerCount)
+        return {frame.leds, 0};
+    const Layer &l = layers[index];
+    return frame(l.start, l.start + l.size - 1);
+}
+
+void Compositor::setOpacity(const uint8_t index, const uint8_t opacity) {
+    if (index < layerCount)
+        layers[index].opacity = opacity;
+}
+
+void Compositor::setBlendMode(const uint8_t index, const BlendMode mode) {
+    if (index < layerCount)
+        layers[index].mode = mode;
+}
+
+/**
+ * Composites the layers, bottom to top, into the target set in one pass - for every pixel of the target, all the layers are applied
+ * @param target color set receiving the layers - its current content is the bottom of the stack
+ */
+void Compositor::composite(CRGBSet &target) const {
+    const Layer *active[MAX_LAYERS];
+    uint8_t activeCount = 0;
+    for (uint8_t x = 0; x < layerCount; x++)
+        if (layers[x].opacity > 0)
+            active[activeCount++] = &layers[x];
+    if (activeCount == 0)
+        return;
+    const uint16_t szTarget = target.size();
+    for (uint16_t x = 0; x < szTarget; x++) {
+        CRGB &px = target[x];
+        for (uint8_t y = 0; y < activeCount; y++) {
+            const Layer &l = *active[y];
+            if (x >= l.size)
+                continue;
+            const CRGB &top = frame[l.start + x];
+            CRGB res = px;
+            switch (l.mode) {
+                case BlendNormal: res = top; break;
+                case BlendAdd:
+                    if (!top)
+                        continue;
+                    res += top;
+                    break;
+                case BlendMultiply: blendMultiply(res, top); break;
+                case BlendScreen:
+                    if (!top)
+                        continue;
+                    blendScreen(res, top);
+                    break;
+                case BlendOverlay: blendOverlay(res, top); break;
+            }
+            if (l.opacity == 255)
+                px = res;
+            else
+                nblend(px, res, l.opacity);
+        }
+    }
+}
+
+/**
+ * Removes all the layers - the frame array is available again in its entirety
+ */
+void Compositor::reset() {
+    layerCount = 0;
+    used = 0;
+}
+
+uint8_t Compositor::size() const {
+    return layerCount;
+}
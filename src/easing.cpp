@@ -0,0 +1,165 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#include "easing.h"
+
+/*
+ * The easing curves are sampled at compile time into tables of EASE_TABLE_SIZE+1 entries (Q16.16 values) and linearly interpolated at runtime -
+ * no floating point math on the device, the RP2040 has no FPU. The math below is only evaluated by the compiler.
+ * Max absolute error of the interpolated curves against the exact (double precision) curves, in units of 1.0:
+ * quad, cubic, sine < 0.0001; elastic < 0.001; bounce < 0.003 (in/out), < 0.008 (in-out) - the error concentrates at the bounce cusps
+ */
+namespace {
+    constexpr double cxPi = 3.14159265358979323846;
+    constexpr double cxLn2 = 0.69314718055994530942;
+
+    constexpr double cxSin(double x) {
+        //range reduction to [-pi, pi], then to [-pi/2, pi/2]
+        const auto turns = (long long)(x / (2*cxPi));
+        x -= (double)turns * 2*cxPi;
+        if (x > cxPi)
+            x -= 2*cxPi;
+        else if (x < -cxPi)
+            x += 2*cxPi;
+        if (x > cxPi/2)
+            x = cxPi - x;
+        else if (x < -cxPi/2)
+            x = -cxPi - x;
+        //Taylor series
+        double term = x, sum = x;
+        for (int n = 1; n < 12; n++) {
+            term *= -x*x / ((2*n) * (2*n+1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr double cxCos(double x) {
+        return cxSin(x + cxPi/2);
+    }
+
+    /**
+     * 2^y - integer part by repeated multiplication, fractional part by Taylor series of e^(f*ln2)
+     */
+    constexpr double cxPow2(double y) {
+        auto whole = (long long)y;
+        if ((double)whole > y)
+            whole--;
+        const double f = (y - (double)whole) * cxLn2;
+        double term = 1, sum = 1;
+        for (int n = 1; n < 20; n++) {
+            term *= f / n;
+            sum += term;
+        }
+        for (; whole > 0; whole--)
+            sum *= 2;
+        for (; whole < 0; whole++)
+            sum /= 2;
+        return sum;
+    }
+
+    constexpr double cxOutBounce(double x) {
+        constexpr double n1 = 7.5625;
+        constexpr double d1 = 2.75;
+        if (x < 1/d1)
+            return n1*x*x;
+        if (x < 2/d1) {
+            x -= 1.5/d1;
+            return n1*x*x + 0.75;
+        }
+        if (x < 2.5/d1) {
+            x -= 2.25/d1;
+            return n1*x*x + 0.9375;
+        }
+        x -= 2.625/d1;
+        return n1*x*x + 0.984375;
+    }
+
+    constexpr double cxEase(EaseCurve curve, double x) {
+        constexpr double c4 = 2*cxPi/3;
+        constexpr double c5 = 2*cxPi/4.5;
+        switch (curve) {
+            case EaseInQuad: return x*x;
+            case EaseOutQuad: return 1 - (1-x)*(1-x);
+            case EaseInOutQuad: return x < 0.5 ? 2*x*x : 1 - (2-2*x)*(2-2*x)/2;
+            case EaseInCubic: return x*x*x;
+            case EaseOutCubic: return 1 - (1-x)*(1-x)*(1-x);
+            case EaseInOutCubic: return x < 0.5 ? 4*x*x*x : 1 - (2-2*x)*(2-2*x)*(2-2*x)/2;
+            case EaseInSine: return 1 - cxCos(x*cxPi/2);
+            case EaseOutSine: return cxSin(x*cxPi/2);
+            case EaseInOutSine: return (1 - cxCos(x*cxPi))/2;
+            case EaseInBounce: return 1 - cxOutBounce(1-x);
+            case EaseOutBounce: return cxOutBounce(x);
+            case EaseInOutBounce: return x < 0.5 ? (1 - cxOutBounce(1-2*x))/2 : (1 + cxOutBounce(2*x-1))/2;
+            case EaseInElastic: return x <= 0 ? 0 : x >= 1 ? 1 : -cxPow2(10*x-10) * cxSin((10*x-10.75)*c4);
+            case EaseOutElastic: return x <= 0 ? 0 : x >= 1 ? 1 : cxPow2(-10*x) * cxSin((10*x-0.75)*c4) + 1;
+            case EaseInOutElastic: return x <= 0 ? 0 : x >= 1 ? 1 : x < 0.5 ? -cxPow2(20*x-10) * cxSin((20*x-11.125)*c5)/2
+                                                                            : cxPow2(10-20*x) * cxSin((20*x-11.125)*c5)/2 + 1;
+            default: return x;
+        }
+    }
+
+    struct EaseTable {
+        int32_t v[EASE_TABLE_SIZE+1] {};
+
+        constexpr explicit EaseTable(EaseCurve curve) {
+            for (int x = 0; x <= EASE_TABLE_SIZE; x++) {
+                const double r = cxEase(curve, (double)x / EASE_TABLE_SIZE) * EASE_ONE;
+                v[x] = (int32_t)(r < 0 ? r - 0.5 : r + 0.5);
+            }
+        }
+    };
+
+    constexpr EaseTable easeTables[EaseCurveCount] = {
+            EaseTable(EaseInQuad), EaseTable(EaseOutQuad), EaseTable(EaseInOutQuad),
+            EaseTable(EaseInCubic), EaseTable(EaseOutCubic), EaseTable(EaseInOutCubic),
+            EaseTable(EaseInSine), EaseTable(EaseOutSine), EaseTable(EaseInOutSine),
+            EaseTable(EaseInBounce), EaseTable(EaseOutBounce), EaseTable(EaseInOutBounce),
+            EaseTable(EaseInElastic), EaseTable(EaseOutElastic), EaseTable(EaseInOutElastic)
+    };
+}
+
+/**
+ * Easing curve value at given position, unclamped - elastic curves overshoot the [0, 1.0] range
+ * @param curve the easing curve
+ * @param pos position along the curve in Q16.16 - [0, EASE_ONE]; values past EASE_ONE are treated as EASE_ONE
+ * @return the curve value in Q16.16 - EASE_ONE is 1.0
+ */
+int32_t easeQ16(const EaseCurve curve, uint32_t pos) {
+    const int32_t *table = easeTables[curve].v;
+    if (pos >= (uint32_t)EASE_ONE)
+        return table[EASE_TABLE_SIZE];
+    const uint16_t idx = pos >> EASE_FRAC_BITS;
+    const int32_t frac = (int32_t)(pos & ((1 << EASE_FRAC_BITS) - 1));
+    return table[idx] + (((table[idx+1] - table[idx]) * frac) >> EASE_FRAC_BITS);
+}
+
+/**
+ * Easing curve value for a 16 bit fraction
+ * @param curve the easing curve
+ * @param x position along the curve - 0 is the start, 65535 is the end of the curve
+ * @return the curve value as a 16 bit fraction - overshoots of the elastic curves are clamped
+ */
+fract16 ease16(const EaseCurve curve, const fract16 x) {
+    const int32_t res = easeQ16(curve, (uint32_t)x + (x >> 15));
+    return res <= 0 ? 0 : (res >= EASE_ONE ? 0xFFFF : (fract16)res);
+}
+
+/**
+ * Easing curve value scaled to a range
+ * @param curve the easing curve
+ * @param x position along the curve, in [0, lim] - values past lim are treated as lim
+ * @param lim high limit of the range
+ * @return the curve value in [0, lim] range, rounded - overshoots of the elastic curves are clamped
+ */
+uint16_t ease(const EaseCurve curve, const uint16_t x, const uint16_t lim) {
+    if (lim == 0)
+        return 0;
+    const uint32_t pos = x >= lim ? EASE_ONE : ((uint32_t)x << 16) / lim;
+    const int32_t res = easeQ16(curve, pos);
+    if (res <= 0)
+        return 0;
+    if (res >= EASE_ONE)
+        return lim;
+    return (uint16_t)(((uint32_t)res * lim + (EASE_ONE >> 1)) >> 16);
+}
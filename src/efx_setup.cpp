@@ -3,10 +3,14 @@
 //
 #include "efx_setup.h"
 #include "log.h"
+#include "fxbench.h"
+#include <mbed.h>
+#include <new>
+#include <algorithm>
 
 //~ Global variables definition
 #define STATE_JSON_DOC_SIZE   512
-const uint8_t dimmed = 20;
+const uint8_t dimmed = 44;
 const char csAutoFxRoll[] = "autoFxRoll";
 const char csStripBrightness[] = "stripBrightness";
 const char csAudioThreshold[] = "audioThreshold";
@@ -15,31 +19,30 @@ const char csAutoColorAdjust[] = "autoColorAdjust";
 const char csRandomSeed[] = "randomSeed";
 const char csCurFx[] = "curFx";
 
-//const uint16_t FRAME_SIZE = 68;     //NOTE: frame size must be at least 3 times less than NUM_PIXELS. The frame CRGBSet must fit at least 3 frames
 const CRGB BKG = CRGB::Black;
-const uint8_t maxChanges = 24;
-const uint8_t minBrightness = 24;
+const uint16_t paletteBlendTime = 25000;    //time (ms) the current palette takes to blend into a new target palette
+const uint8_t minBrightness = 87;
 volatile bool fxBump = false;
 volatile uint16_t speed = 100;
 volatile uint16_t curPos = 0;
 
 EffectRegistry fxRegistry;
-CRGB leds[NUM_PIXELS];
-CRGBArray<NUM_PIXELS> frame;
+//pixel buffers are sized for the largest strip supported; the active layout uses the first numPixels of them
+CRGB leds[MAX_NUM_PIXELS];
+CRGBArray<MAX_NUM_PIXELS> frame;
 CRGBSet ledSet(leds, NUM_PIXELS);
+RingSet ledRing(leds, NUM_PIXELS);                    //rotating-origin view of the whole strip - see StripOutput
 CRGBSet tpl(leds, FRAME_SIZE);                        //array length, indexes go from 0 to length-1
-CRGBSet others(leds, tpl.size(), NUM_PIXELS-1); //start and end indexes are inclusive
-//Room segments
-CRGBSet segUp(leds, SEG_UP_START, SEG_UP_END);
-CRGBSet segRight(leds, SEG_RIGHT_START, SEG_RIGHT_END);
-CRGBSet segFront(leds, SEG_FRONT_START, SEG_FRONT_END);
-CRGBSet segLeft(leds, SEG_LEFT_START, SEG_LEFT_END);
-CRGBSet segBack(leds, SEG_BACK_START, NUM_PIXELS-1);
-
-CRGBPalette16 palette;
-CRGBPalette16 targetPalette;
+CRGBSet others(leds + FRAME_SIZE, NUM_PIXELS - FRAME_SIZE);  //rest of the strip, possibly empty - see applyLayout
+//Room segments - per the default layout; these and the sets spanning the whole strip above are re-seated on the active layout by applyLayout
+CRGBSet segUp(leds, defaultLayout[SegUp].start, defaultLayout[SegUp].end);
+CRGBSet segRight(leds, defaultLayout[SegRight].start, defaultLayout[SegRight].end);
+CRGBSet segFront(leds, defaultLayout[SegFront].start, defaultLayout[SegFront].end);
+CRGBSet segLeft(leds, defaultLayout[SegLeft].start, defaultLayout[SegLeft].end);
+CRGBSet segBack(leds, defaultLayout[SegBack].start, defaultLayout[SegBack].end);
+
 OpMode mode = Chase;
-uint8_t brightness = 128;
+uint8_t brightness = 186;
 uint8_t stripBrightness = brightness;
 bool partyMode = false;
 uint8_t colorIndex = 10;
@@ -51,7 +54,7 @@ uint8_t saturation = 100;
 uint8_t dotBpm = 30;
 uint8_t twinkrate = 100;
 uint16_t szStack = 0;
-uint16_t stripShuffleIndex[NUM_PIXELS];
+uint16_t stripShuffleIndex[MAX_NUM_PIXELS];
 uint16_t hueDiff = 256;
 uint16_t totalAudioBumps = 0;
 int8_t rot = 1;
@@ -66,13 +69,61 @@ float maxTemp = 0.0f;
 EffectTransition transEffect;
 
 //~ Support functions -----------------
+/**
+ * Registers the FastLED controller of an output (data line) with the output's range of the wire buffer
+ * @tparam PIN data pin of the output - PIO driven controllers need it at compile time
+ * @param index output index
+ */
+template<uint8_t PIN> void addOutput(const uint8_t index) {
+    const LedOutput &out = stripOutput.output(index);
+    CFastLED::addLeds<CHIPSET, PIN, COLOR_ORDER>(stripOutput.wireBuffer() + out.start, out.size);
+}
+
+/**
+ * Re-seats the global color sets spanning the strip (whole strip, template, rest of the strip past the template, room segments) on the active
+ * layout. Runs at boot, after the layout has been read and before any effect holds onto these sets. The template is <code>FRAME_SIZE</code>
+ * pixels, or the whole strip when that is shorter - the rest of the strip is then empty
+ */
+void applyLayout() {
+    //the color sets' assignment operator copies pixels, not the view - construct the views in place
+    new (&ledSet) CRGBSet(leds, numPixels);
+    new (&ledRing) RingSet(leds, numPixels);
+    new (&tpl) CRGBSet(leds, min((uint16_t)FRAME_SIZE, numPixels));
+    new (&others) CRGBSet(leds + tpl.size(), numPixels - tpl.size());
+    new (&segUp) CRGBSet(leds, roomLayout[SegUp].start, roomLayout[SegUp].end);
+    new (&segRight) CRGBSet(leds, roomLayout[SegRight].start, roomLayout[SegRight].end);
+    new (&segFront) CRGBSet(leds, roomLayout[SegFront].start, roomLayout[SegFront].end);
+    new (&segLeft) CRGBSet(leds, roomLayout[SegLeft].start, roomLayout[SegLeft].end);
+    new (&segBack) CRGBSet(leds, roomLayout[SegBack].start, roomLayout[SegBack].end);
+}
+
 /**
  * Setup the strip LED lights to be controlled by FastLED library
  */
 void ledStripInit() {
-    CFastLED::addLeds<CHIPSET, LED_PIN, COLOR_ORDER>(leds, NUM_PIXELS).setCorrection(TypicalSMD5050).setTemperature(Tungsten100W);
+    //the controllers shift out the output stage's wire buffer as is - color correction, temperature and brightness are applied by the
+    //output stage; effects render into leds (the back buffer)
+    stripOutput.mapOutputs();
+#ifdef FX_BENCHMARK
+    //benchmark builds record the frames rather than pushing them to the strip
+    CFastLED::addLeds(&benchSink, stripOutput.wireBuffer(), numPixels);
+#else
+    constexpr uint8_t pins[] = LED_OUTPUT_PINS;
+    addOutput<pins[0]>(0);
+#if LED_OUTPUTS > 1
+    addOutput<pins[1]>(1);
+#endif
+#if LED_OUTPUTS > 2
+    addOutput<pins[2]>(2);
+#endif
+#if LED_OUTPUTS > 3
+    addOutput<pins[3]>(3);
+#endif
+#endif
     FastLED.setBrightness(BRIGHTNESS);
-    FastLED.clear(true);
+    FastLED.setDither(DISABLE_DITHER);
+    stripOutput.begin();
+    stripOutput.clear();
 }
 
 void stateLED(CRGB color) {
@@ -170,14 +221,18 @@ bool isSleepTime(const time_t time = 0) {
  */
 void resetGlobals() {
     //turn off the LEDs on the strip and the frame buffer
-    FastLED.clear(true);
     FastLED.setBrightness(BRIGHTNESS);
+    stripOutput.setTemperature(OUTPUT_TEMPERATURE);
+    stripOutput.setTemplate(0);
+    stripOutput.setHighRes(false);
+    stripOutput.clear();
     frame.fill_solid(BKG);
+    compositor.reset();
 
-    palette = paletteFactory.mainPalette();
-    targetPalette = paletteFactory.secondaryPalette();
+    paletteBlender.setPalette(paletteFactory.mainPalette());
+    paletteBlender.setTarget(paletteFactory.secondaryPalette());
     mode = Chase;
-    brightness = 128;
+    brightness = 186;
     colorIndex = lastColorIndex = 0;
     curPos = 0;
     speed = 100;
@@ -197,53 +252,123 @@ void resetGlobals() {
 
     //shuffle led indexes - when engaging secureRandom functions, each call is about 30ms. Shuffling a 320 items array (~200 swaps and secure random calls) takes about 6 seconds!
     //commented in favor of regular shuffle (every 5 minutes) - see fxRun
-    //shuffleIndexes(stripShuffleIndex, NUM_PIXELS);
+    //shuffleIndexes(stripShuffleIndex, numPixels);
 }
 
 /**
- * Ease Out Bounce implementation - leverages the double precision original implementation converted to int in a range
+ * Ease Out Bounce - table based, see <code>ease</code>
  * @param x input value
  * @param lim high limit range
  * @return the result in [0,lim] inclusive range
  * @see https://easings.net/#easeOutBounce
  */
 uint16_t easeOutBounce(const uint16_t x, const uint16_t lim) {
-    static const float d1 = 2.75f;
-    static const float n1 = 7.5625f;
-
-    float xf = ((float)x)/(float)lim;
-    float res = 0;
-    if (xf < 1/d1) {
-        res = n1*xf*xf;
-    } else if (xf < 2/d1) {
-        float xf1 = xf - 1.5f/d1;
-        res = n1*xf1*xf1 + 0.75f;
-    } else if (xf < 2.5f/d1) {
-        float xf1 = xf - 2.25f/d1;
-        res = n1*xf1*xf1 + 0.9375f;
-    } else {
-        float xf1 = xf - 2.625f/d1;
-        res = n1*xf1*xf1 + 0.984375f;
-    }
-    return (uint16_t )(res * (float)lim);
+    return ease(EaseOutBounce, x, lim);
 }
 
 /**
- * Ease Out Quad implementation - leverages the double precision original implementation converted to int in a range
+ * Ease Out Quad - table based, see <code>ease</code>
  * @param x input value
  * @param lim high limit range
  * @return the result in [0,lim] inclusive range
  * @see https://easings.net/#easeOutQuad
  */
 uint16_t easeOutQuad(const uint16_t x, const uint16_t lim) {
-    auto limf = float(lim);
-    float xf = float(x)/limf;
-    return uint16_t((1 - (1-xf)*(1-xf))*limf);
+    return ease(EaseOutQuad, x, lim);
+}
+
+/**
+ * Contiguous pixels of a color set, addressed by the set's indexes. The direction of the set is a compile time parameter - the block
+ * operations below resolve into plain memmove/fill/rotate over the set's memory, for either direction
+ * @tparam Reversed whether the set runs backwards in memory - its first pixel is at the highest address
+ */
+template<bool Reversed> struct PixelSpan {
+    CRGB *base;     //lowest address pixel of the set
+    uint16_t sz;    //number of pixels in the set
+
+    /**
+     * Memory address of a range of the set's pixels
+     * @param from first index of the range
+     * @param count number of pixels in the range
+     * @return the lowest address of the range
+     */
+    CRGB *at(const uint16_t from, const uint16_t count) const {
+        return Reversed ? base + sz - from - count : base + from;
+    }
+
+    void move(const uint16_t to, const uint16_t from, const uint16_t count) const {
+        if (count > 0)
+            memmove(at(to, count), at(from, count), count * sizeof(CRGB));
+    }
+
+    void fill(const uint16_t from, const uint16_t count, const CRGB &color) const {
+        fill_solid(at(from, count), count, color);
+    }
+
+    void rotateRight(const uint16_t from, const uint16_t count, const uint16_t pos) const {
+        CRGB *first = at(from, count);
+        std::rotate(first, Reversed ? first + pos : first + count - pos, first + count);
+    }
+};
+
+template<bool Reversed> static PixelSpan<Reversed> spanOf(CRGBSet &set) {
+    return {Reversed ? set.leds + set.len + 1 : set.leds, (uint16_t)set.size()};
+}
+
+template<bool Reversed> static void shiftRight(const PixelSpan<Reversed> &span, const CRGB &feedLeft, const Viewport &vwp, const uint16_t pos) {
+    if (pos >= vwp.size()) {
+        const uint16_t hiMark = capu(vwp.high, (span.sz-1));
+        span.fill(vwp.low, hiMark - vwp.low + 1, feedLeft);
+        return;
+    }
+    const uint16_t hiMark = capu(vwp.high, span.sz);
+    //pixels at indexes below pos are fed, the others come from pos positions to the left - possibly from below the viewport
+    const uint16_t moveStart = max(vwp.low, pos);
+    if (hiMark > moveStart)
+        span.move(moveStart, moveStart - pos, hiMark - moveStart);
+    if (pos > vwp.low)
+        span.fill(vwp.low, min(pos, hiMark) - vwp.low, feedLeft);
+}
+
+template<bool Reversed> static void loopRight(const PixelSpan<Reversed> &span, const Viewport &vwp, uint16_t pos) {
+    const uint16_t hiMark = capu(vwp.high, span.sz);
+    if (pos >= hiMark)
+        pos %= hiMark;  //viewport extends past the set - the rotation wraps at the set's end
+    if (pos <= vwp.low) {
+        //no pixel of the viewport wraps around - all come from pos positions to the left
+        span.move(vwp.low, vwp.low - pos, hiMark - vwp.low);
+        return;
+    }
+    //same as rotating [0, hiMark) while keeping the pixels below the viewport: the last (pos - low) pixels wrap around to the viewport's start,
+    //the pixels below the viewport are carried into it at pos
+    span.rotateRight(vwp.low, hiMark - vwp.low, pos - vwp.low);
+    const uint16_t szTail = hiMark - pos;
+    if (szTail > vwp.low) {
+        span.move(pos + vwp.low, pos, szTail - vwp.low);
+        span.move(pos, 0, vwp.low);
+    } else
+        span.move(pos, 0, szTail);
+}
+
+template<bool Reversed> static void shiftLeft(const PixelSpan<Reversed> &span, const CRGB &feedRight, const Viewport &vwp, const uint16_t pos) {
+    const uint16_t hiMark = capu(vwp.high, (span.sz-1));
+    if (pos >= vwp.size()) {
+        span.fill(vwp.low, hiMark - vwp.low + 1, feedRight);
+        return;
+    }
+    //pixels at indexes from (size - pos) up are fed, the others come from pos positions to the right - possibly from above the viewport
+    const uint16_t end = hiMark + 1;
+    const uint16_t feedStart = pos < span.sz ? max(vwp.low, (uint16_t)(span.sz - pos)) : vwp.low;
+    if (feedStart > vwp.low)
+        span.move(vwp.low, vwp.low + pos, min(feedStart, end) - vwp.low);
+    if (end > feedStart)
+        span.fill(feedStart, end - feedStart, feedRight);
 }
 
 /**
  * Shifts the content of an array to the right by the number of positions specified
  * First item of the array (arr[0]) is used as seed to fill the new elements entering left
+ * <p>The pixels are moved in blocks - memmove and fill over the set's memory, in either direction</p>
  * @param arr array
  * @param szArr size of the array
  * @param vwp limits of the shifting area
@@ -255,22 +380,16 @@ void shiftRight(CRGBSet &set, CRGB feedLeft, Viewport vwp, uint16_t pos) {
         return;
     if (vwp.size() == 0)
         vwp = (Viewport)set.size();
-    if (pos >= vwp.size()) {
-        uint16_t hiMark = capu(vwp.high, (set.size()-1));
-        set(vwp.low, hiMark) = feedLeft;
-        return;
-    }
-    uint16_t hiMark = capu(vwp.high, set.size());
-    //don't use >= as the indexer is unsigned and always >=0 --> infinite loop
-    for (uint16_t x = hiMark; x > vwp.low; x--) {
-        uint16_t y = x - 1;
-        set[y] = y < pos ? feedLeft : set[y-pos];
-    }
+    if (set.reversed())
+        shiftRight(spanOf<true>(set), feedLeft, vwp, pos);
+    else
+        shiftRight(spanOf<false>(set), feedLeft, vwp, pos);
 }
 
 /**
  * Shifts the contents of an CRGBSet to the right in a circular buffer manner - the elements falling off to the right
  * are entering through the left
+ * <p>The rotation is done in place (<code>std::rotate</code> and block moves) - no scratch buffer on the stack</p>
  * @param set the set
  * @param vwp limits of the shifting area
  * @param pos how many positions to shift right
@@ -280,20 +399,19 @@ void loopRight(CRGBSet &set, Viewport vwp, uint16_t pos) {
         return;
     if (vwp.size() == 0)
         vwp = (Viewport)set.size();
-    uint16_t hiMark = capu(vwp.high, set.size());
     pos = pos % vwp.size();
-    CRGB buf[pos];
-    for (uint16_t x = hiMark; x > vwp.low; x--) {
-        uint16_t y = x - 1;
-        if (hiMark-x < pos)
-            buf[hiMark-x] = set[y];
-        set[y] = y < pos ? buf[pos-y-1] : set[y-pos];
-    }
+    if (pos == 0)
+        return;
+    if (set.reversed())
+        loopRight(spanOf<true>(set), vwp, pos);
+    else
+        loopRight(spanOf<false>(set), vwp, pos);
 }
 
 /**
  * Shifts the content of an array to the left by the number of positions specified
  * The elements entering right are filled with current's array last value (arr[szArr-1])
+ * <p>The pixels are moved in blocks - memmove and fill over the set's memory, in either direction</p>
  * @param arr array
  * @param szArr size of the array
  * @param vwp limits of the shifting area
@@ -305,15 +423,74 @@ void shiftLeft(CRGBSet &set, CRGB feedRight, Viewport vwp, uint16_t pos) {
         return;
     if (vwp.size() == 0)
         vwp = (Viewport)set.size();
-    uint16_t hiMark = capu(vwp.high, (set.size()-1));
-    if (pos >= vwp.size()) {
-        set(vwp.low, hiMark) = feedRight;
+    if (set.reversed())
+        shiftLeft(spanOf<true>(set), feedRight, vwp, pos);
+    else
+        shiftLeft(spanOf<false>(set), feedRight, vwp, pos);
+}
+
+/**
+ * Whether a viewport spans an entire ring - the shifts and rotations of the ring can then move its origin rather than its pixels
+ * @param ring the ring
+ * @param vwp the viewport; an empty viewport stands for the entire ring
+ * @return true if the viewport covers the ring
+ */
+static bool isFullView(const RingSet &ring, const Viewport &vwp) {
+    return vwp.size() == 0 || (vwp.low == 0 && vwp.high >= ring.size());
+}
+
+/**
+ * Shifts the content of a ring to the right - same outcome as <code>shiftRight(CRGBSet&, ...)</code>. A shift of the entire ring moves its
+ * origin and writes only the pixels fed in; a viewport restricted shift linearizes the ring first and shifts its pixels
+ * @param ring the ring
+ * @param feedLeft the color to introduce from the left as we shift the ring
+ * @param vwp limits of the shifting area
+ * @param pos how many positions to shift right
+ */
+void shiftRight(RingSet &ring, CRGB feedLeft, Viewport vwp, uint16_t pos) {
+    if (isFullView(ring, vwp)) {
+        ring.shiftRight(feedLeft, pos);
         return;
     }
-    for (uint16_t x = vwp.low; x <= hiMark; x++) {
-        uint16_t y = x + pos;
-        set[x] = y < set.size() ? set[y] : feedRight;
+    ring.linearize();
+    CRGBSet set(ring.data(), ring.size());
+    shiftRight(set, feedLeft, vwp, pos);
+}
+
+/**
+ * Rotates the content of a ring to the right - same outcome as <code>loopRight(CRGBSet&, ...)</code>. A rotation of the entire ring moves its
+ * origin only; a viewport restricted rotation linearizes the ring first and moves its pixels
+ * @param ring the ring
+ * @param vwp limits of the shifting area
+ * @param pos how many positions to shift right
+ */
+void loopRight(RingSet &ring, Viewport vwp, uint16_t pos) {
+    if (isFullView(ring, vwp)) {
+        //a viewport past the end of the ring wraps the rotation at the viewport's size first - as the color set does
+        ring.rotateRight(vwp.size() > 0 ? pos % vwp.size() : pos);
+        return;
     }
+    ring.linearize();
+    CRGBSet set(ring.data(), ring.size());
+    loopRight(set, vwp, pos);
+}
+
+/**
+ * Shifts the content of a ring to the left - same outcome as <code>shiftLeft(CRGBSet&, ...)</code>. A shift of the entire ring moves its
+ * origin and writes only the pixels fed in; a viewport restricted shift linearizes the ring first and shifts its pixels
+ * @param ring the ring
+ * @param feedRight the color to introduce from the right as we shift the ring
+ * @param vwp limits of the shifting area
+ * @param pos how many positions to shift left
+ */
+void shiftLeft(RingSet &ring, CRGB feedRight, Viewport vwp, uint16_t pos) {
+    if (isFullView(ring, vwp)) {
+        ring.shiftLeft(feedRight, pos);
+        return;
+    }
+    ring.linearize();
+    CRGBSet set(ring.data(), ring.size());
+    shiftLeft(set, feedRight, vwp, pos);
 }
 
 /**
@@ -396,6 +573,7 @@ bool areSame(const CRGBSet &lhs, const CRGBSet &rhs) {
 /**
  * Replicate the source set into destination, repeating it as necessary to fill the entire destination
  * <p>Any overlaps between source and destination are skipped from replication - source set backing array is guaranteed unchanged</p>
+ * <p>When neither set is reversed and they do not overlap, the source is copied in whole blocks</p>
  * @param src source set
  * @param dest destination set
  */
@@ -406,7 +584,20 @@ void replicateSet(const CRGBSet& src, CRGBSet& dest) {
     CRGB* normDestStart = dest.reversed() ? dest.end_pos : dest.leds;
     CRGB* normDestEnd = dest.reversed() ? dest.leds : dest.end_pos;
     uint16_t x = 0;
-    if (max(normSrcStart, normDestStart) < min(normSrcEnd, normDestEnd)) {
+    const bool overlap = max(normSrcStart, normDestStart) < min(normSrcEnd, normDestEnd);
+    if (!overlap && (src.len > 0) && !dest.reversed()) {
+        //contiguous forward sets - block copies
+        CRGB *dst = dest.leds;
+        uint16_t remaining = dest.size();
+        while (remaining > 0) {
+            const uint16_t szBlock = min(remaining, srcSize);
+            memcpy(dst, src.leds, szBlock * sizeof(CRGB));
+            dst += szBlock;
+            remaining -= szBlock;
+        }
+        return;
+    }
+    if (overlap) {
         //we have overlap - account for it
         for (auto & y : dest) {
             CRGB* yPtr = &y;
@@ -516,34 +707,6 @@ void mirrorHigh(CRGBSet &set) {
     }
 }
 
-/**
- * Adjust the brightness of the given color
- * <p>Code borrowed from <code>ColorFromPalette</code> function</p>
- * @param color color to change
- * @param bright brightness to apply
- * @return new color instance with desired brightness
- */
-CRGB adjustBrightness(CRGB color, uint8_t bright) {
-    //inspired from ColorFromPalette implementation of applying brightness factor
-    uint8_t r = color.r, g = color.g, b = color.b;
-    if (bright != 255) {
-        if (bright) {
-            ++bright; // adjust for rounding
-            // Now, since localBright is nonzero, we don't need the full scale8_video logic;
-            // we can just to scale8 and then add one (unless scale8 fixed) to all nonzero inputs.
-            if (r)
-                r = scale8_LEAVING_R1_DIRTY(r, bright);
-            if (g)
-                g = scale8_LEAVING_R1_DIRTY( g, bright);
-            if (b)
-                b = scale8_LEAVING_R1_DIRTY( b, bright);
-            cleanup_R1();
-        } else
-            r = g = b = 0;
-    }
-    return {r, g, b};
-}
-
 /**
  * Blend multiply 2 colors
  * @param blendRGB base color, which is also the target (the one receiving the result)
@@ -663,9 +826,46 @@ bool rblend(CRGB &existing, const CRGB &target, const fract8 frOverlay) {
     return bRed && bGreen && bBlue;
 }
 
+/**
+ * Blends one 16 bit channel towards a target value - moves by the overlay fraction of the distance, at least one unit
+ * @param a channel to modify
+ * @param b target value
+ * @param amt fraction (number of 256-ths) of the distance to move
+ * @return true if the channel has reached the target value
+ */
+static bool rblend16(uint16_t &a, const uint16_t b, const fract8 amt) {
+    if (a < b)
+        a += capd(((uint32_t)(b - a) * amt) >> 8, 1);
+    else if (a > b)
+        a -= capd(((uint32_t)(a - b) * amt) >> 8, 1);
+    return a == b;
+}
+
+/**
+ * High resolution flavor of <code>rblend</code> - blends the target color into an existing (in-place) with 16 bit channels, such that
+ * after a number of iterations the existing becomes equal with the target
+ * @param existing color to modify
+ * @param target target color
+ * @param frOverlay fraction (number of 256-ths) of the target color to blend into existing. 0 is a no-op, 255 forces the existing to
+ * equal to target
+ * @return true if the existing color has become equal with target or overlay fraction is 0 (no blending); false otherwise
+ */
+bool rblend16(CRGB16 &existing, const CRGB16 &target, const fract8 frOverlay) {
+    if (frOverlay == 0)
+        return true;
+    if (frOverlay == 255) {
+        existing = target;
+        return true;
+    }
+    bool bRed = rblend16(existing.r, target.r, frOverlay);
+    bool bGreen = rblend16(existing.g, target.g, frOverlay);
+    bool bBlue = rblend16(existing.b, target.b, frOverlay);
+    return bRed && bGreen && bBlue;
+}
+
 
 /**
- * Adjust strip overall brightness according with the time of day - as follows:
+ * Adjust strip overall brightness according with the time of day - the brightness is perceptual (see OUTPUT_GAMMA), as follows:
  * <p>7am until 8pm use the max brightness - i.e. <code>BRIGHTNESS</code></p>
  * <p>Between 8pm-9pm - reduce to 80% of full brightness, i.e. scale with 204</p>
  * <p>Between 9-10pm - reduce to 60% of full brightness, i.e. scale with 152</p>
@@ -686,7 +886,7 @@ uint8_t adjustStripBrightness() {
         else
             scale = 102;
         if (scale > 0)
-            return dim8_raw(scale8(FastLED.getBrightness(), scale));
+            return scale8(FastLED.getBrightness(), scale);
     }
     return FastLED.getBrightness();
 }
@@ -799,15 +999,84 @@ void EffectRegistry::setup() {
     transEffect.setup();
 }
 
+/**
+ * Frame scheduler - steps the current effect at its frame period (see <code>LedEffect::frameBudget</code>) and sleeps the fx thread
+ * in between frames. The one-off steps of the effect's state machine (setup, preparations) are run right away.
+ * <p>In crossfade mode (see <code>crossfade</code>) an effect change does not wait for the outgoing effect to wind down: the outgoing effect
+ * is stopped - skipping its wind down - and the last frame it rendered is held, frozen, by the output stage and faded out under the incoming
+ * effect's frames. The outgoing effect does not keep rendering: effects share the global render state (pixel buffer, palettes, parameters
+ * reset by the effect setup, compositor layers, output stage modes), hence only one effect renders at any time</p>
+ * <p>The current effect renders into the strip's pixel buffer through a render context (see <code>RenderContext</code>) - the registry
+ * owns showing the frames rendered, in template mode when the effect rendered a template (see <code>RenderContext::templateSize</code>).
+ * The transitions (wind down, transition break) still push their frames to the strip themselves.</p>
+ */
 void EffectRegistry::loop() {
+    //crossfade - the outgoing effect is cut short right as it is asked to wind down
+    if ((lastEffectRun != currentEffect) && (xfadeTime > 0) && (effects[lastEffectRun]->getState() == WindDownPrep)) {
+        stripOutput.crossfade(xfadeTime);
+        effects[lastEffectRun]->stop();
+    }
     //if effect has changed, re-run the effect's setup
     if ((lastEffectRun != currentEffect) && (effects[lastEffectRun]->getState() == Idle)) {
         Log.infoln(F("Effect change: from index %d [%s] to %d [%s]"),
                 lastEffectRun, effects[lastEffectRun]->description(), currentEffect, effects[currentEffect]->description());
         lastEffectRun = currentEffect;
         lastEffects.push(lastEffectRun);
+        nextFrame = lastRender = millis();
+    }
+    const long wait = (long)(nextFrame - millis());
+    if (wait > 0) {
+        rtos::ThisThread::sleep_for(std::chrono::milliseconds(wait));
+        return;
+    }
+    LedEffect *fx = effects[lastEffectRun];
+    const EffectState ranState = fx->getState();
+    const uint32_t frames = stripOutput.frameCount();
+    const ulong now = millis();
+    RenderContext ctx {ledSet, tpl, others, palette, now, (uint16_t)min(now - lastRender, 0xFFFFul), stripBrightness, 0,
+                       stripOutput.isHighRes() ? stripOutput.highResBuffer() : nullptr};
+    if (ranState == Running)
+        lastRender = now;
+    const bool rendered = fx->loop(ctx);
+    if (rendered)
+        stripOutput.setTemplate(ctx.templateSize);
+    //keeps the crossfade going under effects that render rarely (or not at all, once set up)
+    if (rendered || (stripOutput.isCrossfading() && (stripOutput.frameCount() == frames)))
+        stripOutput.show(ctx.brightness);
+    scheduleNextFrame(fx, ranState);
+}
+
+/**
+ * Establishes when the next frame of the current effect is due, as one frame period from the current frame's scheduled time (fixed timestep).
+ * A frame that completes past the next frame's time is counted as a missed deadline and the schedule is re-synchronized to the current time -
+ * the following frames are not rushed to catch up.
+ * @param fx the current effect
+ * @param ranState the state the effect was in when the frame was run
+ */
+void EffectRegistry::scheduleNextFrame(LedEffect *fx, EffectState ranState) {
+    uint16_t period;
+    switch (ranState) {
+        case Running: period = fx->frameBudget(); break;
+        case WindDown:
+        case TransitionBreak:
+        case Idle: period = TRANSITION_FRAME_TIME; break;
+        default:
+            nextFrame = millis();   //one-off steps - the next step runs right away and the schedule restarts from here
+            return;
+    }
+    nextFrame += period;
+    const ulong now = millis();
+    if ((long)(now - nextFrame) > 0) {
+        if (ranState == Running) {
+            missedFrames++;
+            fx->frameMissed();
+        }
+        nextFrame = now;
     }
-    effects[lastEffectRun]->loop();
+}
+
+uint32_t EffectRegistry::missedFrameCount() const {
+    return missedFrames;
 }
 
 void EffectRegistry::describeConfig(JsonArray &json) {
@@ -827,6 +1096,19 @@ bool EffectRegistry::isAutoRoll() const {
     return autoSwitch;
 }
 
+/**
+ * Configures the crossfade mode - effect changes fade from the outgoing effect's last frame (held, not rendered further) into the incoming
+ * effect rather than winding the outgoing effect down, followed by a pause. Off by default, see FX_CROSSFADE_MS
+ * @param ms crossfade duration, in ms; 0 turns off the crossfade mode
+ */
+void EffectRegistry::crossfade(const uint16_t ms) {
+    xfadeTime = ms;
+}
+
+uint16_t EffectRegistry::crossfadeTime() const {
+    return xfadeTime;
+}
+
 uint16_t EffectRegistry::size() const {
     return effectsCount;
 }
@@ -913,23 +1195,39 @@ bool LedEffect::windDown() {
  * Called only once as the effect transitions into WindDown state, before the loop calls to <code>windDown</code>
  */
 void LedEffect::windDownPrep() {
-    CRGBSet strip(leds, NUM_PIXELS);
+    CRGBSet strip(leds, numPixels);
     strip.nblend(ColorFromPalette(targetPalette, random8(), 72, LINEARBLEND), 80);
-    FastLED.show(stripBrightness);
+    stripOutput.show(stripBrightness);
     transEffect.prepare(rot);
 }
 
 /**
  * Re-entrant looping function
+ * <p>The duration of run() calls is recorded for the calls that rendered a frame, the duration of windDown() calls for the calls that pushed
+ * a frame to the strip - the calls that only wait for their next frame time are not representative of the effect's frame cost</p>
+ * @param ctx render context the effect renders into while running
+ * @return true if the effect has rendered a new frame into the render context that is to be shown; false otherwise
  */
-void LedEffect::loop() {
+bool LedEffect::loop(RenderContext &ctx) {
+    const uint32_t frames = stripOutput.frameCount();
+    const ulong start = micros();
     switch (state) {
         case Setup: setup(); nextState(); break;    //one blocking step, non repeat
-        case Running: run(); break;                 //repeat, called multiple times to achieve the light effects designed
-        case WindDownPrep: windDownPrep(); nextState(); break;
+        case Running:                               //repeat, called multiple times to achieve the light effects designed
+            if (run(ctx)) {
+                runStats.record(micros() - start);
+                return true;
+            }
+            break;
+        case WindDownPrep:
+            stripOutput.setTemplate(0);     //transitions work on the entire pixel buffer
+            stripOutput.setHighRes(false);
+            windDownPrep(); nextState(); break;
         case WindDown:
             if (windDown())
                 nextState();
+            if (stripOutput.frameCount() != frames)
+                windDownStats.record(micros() - start);
             break;           //repeat, called multiple times to achieve the fade out for the current light effect
         case TransitionBreakPrep:
             transitionBreakPrep(); nextState(); break;
@@ -939,6 +1237,7 @@ void LedEffect::loop() {
             break; //repeat, called multiple times to achieve the transition off for the current light effect
         case Idle: break;                           //no-op
     }
+    return false;
 }
 
 /**
@@ -1025,6 +1324,17 @@ void LedEffect::desiredState(EffectState dst) {
     }
 }
 
+/**
+ * Stops the effect right away - skipping the wind down and the transition break. Used by the crossfade between effects, where the outgoing
+ * effect's last frame is faded out by the output stage. The output stage modes the wind down would have disengaged (template, high resolution)
+ * are disengaged here
+ */
+void LedEffect::stop() {
+    stripOutput.setTemplate(0);
+    stripOutput.setHighRes(false);
+    state = Idle;
+}
+
 void LedEffect::nextState() {
     switch (state) {
         case Setup: state = Running; break;
@@ -1048,6 +1358,8 @@ uint16_t Viewport::size() const {
 
 //Setup all effects -------------------
 void fx_setup() {
+    readLayout();
+    applyLayout();
     ledStripInit();
     //if engaging stdlib's random() - we'd need to initialize that as well (randomSeed()), separate implementation. The random8/16 are FastLED specific
     random16_set_seed(secRandom16());
@@ -1059,7 +1371,7 @@ void fx_setup() {
     readState();
     transEffect.setup();
 
-    shuffleIndexes(stripShuffleIndex, NUM_PIXELS);
+    shuffleIndexes(stripShuffleIndex, numPixels);
     //ensure the current effect is moved to setup state
     fxRegistry.getCurrentEffect()->desiredState(Setup);
 }
@@ -1097,7 +1409,7 @@ void fx_run() {
     EVERY_N_MINUTES(7) {
         if (partyMode) {
             fxRegistry.nextRandomEffectPos();
-            shuffleIndexes(stripShuffleIndex, NUM_PIXELS);
+            shuffleIndexes(stripShuffleIndex, numPixels);
             stripBrightness = adjustStripBrightness();
         }
         random16_add_entropy(secRandom16());        //this may or may not help
@@ -22,16 +22,7 @@ void FxA::fxRegister() {
 }
 
 // SleepLight
-SleepLight::SleepLight() : LedEffect(fxa1Desc), state(Fade), refPixel(&segRight[segRight.size()-1]) {
-    slOffSegs.push_front(segUp(0, segUp.size()-4));
-    slOffSegs.push_front(segRight(5, segRight.size()/2-2));
-    slOffSegs.push_front(segRight(segRight.size()/2+2, segRight.size()-6));
-    slOffSegs.push_front(segFront(5, segFront.size()/2-2));
-    slOffSegs.push_front(segFront(segFront.size()/2+2, segFront.size()-6));
-    slOffSegs.push_front(segLeft(5, segLeft.size()/2-2));
-    slOffSegs.push_front(segLeft(segLeft.size()/2+2, segLeft.size()-6));
-    slOffSegs.push_front(segBack(5, segBack.size()/2-2));
-    slOffSegs.push_front(segBack(segBack.size()/2+2, segBack.size()-10));
+SleepLight::SleepLight() : LedEffect(fxa1Desc), state(Fade) {
     fxRegistry.registerEffect(this);
 }
 
@@ -46,11 +37,32 @@ uint8_t excludeActiveColors(uint8_t hue) {
     return res;
 }
 
+/**
+ * Lays out the segments turned off when going to sleep, over the active room layout. The top of the pole, the corners and the middle of each
+ * wall stay lit; their margins scale down with the segment size (the 170 pixels default layout has them at 3, 5 and 2 pixels)
+ */
+void SleepLight::layoutSegments() {
+    slOffSegs.clear();
+    const uint16_t szUp = roomLayout[SegUp].size();
+    slOffSegs.emplace_front(roomLayout[SegUp].start, roomLayout[SegUp].end + 1 - min(3, szUp/8));
+    //each wall is lit in two halves, leaving the corners and the middle of the wall dark
+    for (uint8_t s = SegRight; s <= SegBack; s++) {
+        const SegmentDef &wall = roomLayout[s];
+        const uint16_t mid = wall.start + wall.size()/2;
+        const uint16_t corner = min(5, wall.size()/6), gap = min(2, wall.size()/10);
+        slOffSegs.emplace_front(wall.start + corner, mid + 1 - gap);
+        slOffSegs.emplace_front(mid + gap, wall.end + 1 - (s == SegBack ? min(9, wall.size()/4) : corner));
+    }
+}
+
 void SleepLight::setup() {
     LedEffect::setup();
-    FastLED.setTemperature(ColorTemperature::Tungsten40W);
-    fill_solid(leds, NUM_PIXELS, colorBuf);
-    timer=0;
+    layoutSegments();
+    stripOutput.setTemperature(ColorTemperature::Tungsten40W);
+    //fades in from the color it last went to sleep with
+    litClr = offClr = CRGB16((CRGB)colorBuf);
+    //render in high resolution - the slow fades at low intensity are smooth (dithered) rather than stepping through the 8 bit values
+    stripOutput.setHighRes(true);
     state = FadeColorTransition;
     colorBuf.hue = excludeActiveColors(secRandom8());
     colorBuf.sat = secRandom8(24, 128);
@@ -71,57 +83,79 @@ uint8_t flrSub(uint8_t val, uint8_t sub, uint8_t floor) {
     return res < floor ? floor : res;
 }
 
-void SleepLight::run() {
+bool SleepLight::run(RenderContext &ctx) {
     if (state == Fade) {
         EVERY_N_SECONDS(21) {
             colorBuf.val = flrSub(colorBuf.val, 3, minBrightness);
             state = colorBuf.val > minBrightness ? FadeColorTransition : SleepTransition;
-            Log.infoln(F("SleepLight parameters: state=%d, colorBuf=%r HSV=(%d,%d,%d), refPixel=%r"), state, (CRGB)colorBuf, colorBuf.hue, colorBuf.sat, colorBuf.val, *refPixel);
+            Log.infoln(F("SleepLight parameters: state=%d, colorBuf=%r HSV=(%d,%d,%d), litClr=%r"), state, (CRGB)colorBuf, colorBuf.hue, colorBuf.sat, colorBuf.val, litClr.toCRGB());
         }
         EVERY_N_SECONDS(12) {
             colorBuf.hue = excludeActiveColors(colorBuf.hue + random8(2, 19));
             colorBuf.sat = map(colorBuf.val, minBrightness, brightness, 20, 96);
             state = colorBuf.val > minBrightness ? FadeColorTransition : SleepTransition;
-            Log.infoln(F("SleepLight parameters: state=%d, colorBuf=%r HSV=(%d,%d,%d), refPixel=%r"), state, (CRGB)colorBuf, colorBuf.hue, colorBuf.sat, colorBuf.val, *refPixel);
+            Log.infoln(F("SleepLight parameters: state=%d, colorBuf=%r HSV=(%d,%d,%d), litClr=%r"), state, (CRGB)colorBuf, colorBuf.hue, colorBuf.sat, colorBuf.val, litClr.toCRGB());
         }
     }
-    EVERY_N_MILLIS(125) {
-        SleepLightState oldState = step();
-        if (!(oldState == state && state == Sleep))
-            FastLED.show();
-    }
-
+    step();
+    render(ctx);
+    //frames that have not changed (e.g. Sleep state) are not pushed to the strip
+    ctx.brightness = FastLED.getBrightness();
+    return true;
 }
 
 SleepLight::SleepLightState SleepLight::step() {
     SleepLightState oldState = state;
     switch (state) {
         case FadeColorTransition:
-            if (rblend(*refPixel, (CRGB) colorBuf, 7))
+            if (rblend16(litClr, CRGB16((CRGB) colorBuf), 7))
                 state = Fade;
-            ledSet = *refPixel;
+            offClr = litClr;
             break;
         case SleepTransition:
-            timer = ++timer%12;
-            if (timer == 0) {
-                for (auto &seg : slOffSegs)
-                    seg.fadeToBlackBy(1);
-                if (segUp[0] == CRGB::Black)
-                    state = Sleep;
-            }
+            offClr.r = qsuba(offClr.r, SLEEPLIGHT_FADE_STEP);
+            offClr.g = qsuba(offClr.g, SLEEPLIGHT_FADE_STEP);
+            offClr.b = qsuba(offClr.b, SLEEPLIGHT_FADE_STEP);
+            if (offClr.isBlack())
+                state = Sleep;
             break;
         default:
             break;
     }
     if (oldState != state)
-        Log.infoln(F("SleepLight state changed from %d to %d, colorBuf=%r, refPixel=%r"), oldState, state, (CRGB)colorBuf, *refPixel);
+        Log.infoln(F("SleepLight state changed from %d to %d, colorBuf=%r, litClr=%r"), oldState, state, (CRGB)colorBuf, litClr.toCRGB());
     return oldState;
 }
 
+/**
+ * Renders the frame - the lit color over the whole frame, the off color over the segments turned off when going to sleep. In high
+ * resolution when the context has a 16 bit frame, in 8 bit otherwise (e.g. off-screen renders)
+ * @param ctx render context
+ */
+void SleepLight::render(RenderContext &ctx) const {
+    if (ctx.target16 != nullptr) {
+        for (uint16_t x = 0; x < ctx.target.size(); x++)
+            ctx.target16[x] = litClr;
+        for (const auto &seg : slOffSegs)
+            for (uint16_t x = seg.low; x < seg.high; x++)
+                ctx.target16[x] = offClr;
+        return;
+    }
+    ctx.target = litClr.toCRGB();
+    for (const auto &seg : slOffSegs) {
+        CRGBSet off = ctx.target(seg.low, seg.high - 1);
+        off = offClr.toCRGB();
+    }
+}
+
 uint8_t SleepLight::selectionWeight() const {
     return LedEffect::selectionWeight();
 }
 
+uint16_t SleepLight::frameBudget() const {
+    return 125;
+}
+
 void SleepLight::windDownPrep() {
     transEffect.prepare(SELECTOR_FADE);
 }
@@ -131,12 +165,13 @@ void Quiet::setup() {
     LedEffect::setup();
 }
 
-void Quiet::run() {
+bool Quiet::run(RenderContext &ctx) {
     EVERY_N_SECONDS(30) {
-        CRGBSet strip(leds, NUM_PIXELS);
-        strip = CRGB::Black;
-        FastLED.show(0);
+        ctx.target = CRGB::Black;
+        ctx.brightness = 0;
+        return true;
     }
+    return false;
 }
 
 uint8_t Quiet::selectionWeight() const {
@@ -28,28 +28,26 @@ FxB1::FxB1() : LedEffect(fxb1Desc) {}
 void FxB1::setup() {
     LedEffect::setup();
     hue = 0;
-    brightness = 148;
+    brightness = 199;
     transEffect.prepare(random8());
 }
 
-void FxB1::run() {
-    EVERY_N_MILLISECONDS(60) {
-        rainbow();
-        FastLED.show(stripBrightness);
-        hue += 2;
-    }
+bool FxB1::run(RenderContext &ctx) {
+    rainbow(ctx);
+    hue += 2;
+    return true;
 }
 
-void FxB::rainbow() {
+void FxB::rainbow(RenderContext &ctx) {
     if (paletteFactory.isHolidayLimitedHue())
-        tpl.fill_gradient_RGB(ColorFromPalette(palette, hue, brightness),
-                              ColorFromPalette(palette, hue + 128, brightness),
-                              ColorFromPalette(palette, 255 - hue, brightness));
+        ctx.tpl.fill_gradient_RGB(ColorFromCache(ctx.palette, hue, brightness),
+                                  ColorFromCache(ctx.palette, hue + 128, brightness),
+                                  ColorFromCache(ctx.palette, 255 - hue, brightness));
     else {
-        tpl.fill_rainbow(hue, 7);
-        tpl.nscale8(brightness);
+        ctx.tpl.fill_rainbow(hue, 7);
+        ctx.tpl.nscale8(brightness);
     }
-    replicateSet(tpl, others);
+    replicateSet(ctx.tpl, ctx.others);
 }
 
 JsonObject &FxB1::describeConfig(JsonArray &json) const {
@@ -62,35 +60,37 @@ uint8_t FxB1::selectionWeight() const {
     return 15;
 }
 
+uint16_t FxB1::frameBudget() const {
+    return 60;
+}
+
 //FXB2
 FxB2::FxB2() : LedEffect(fxb2Desc) {}
 
 void FxB2::setup() {
     LedEffect::setup();
     hue = 0;
-    brightness = 148;
+    brightness = 199;
     transEffect.prepare(random8());
 }
 
-void FxB2::run() {
-    EVERY_N_MILLISECONDS(60) {
-        rainbowWithGlitter();
-        FastLED.show(stripBrightness);
-        hue += 2;
-    }
+bool FxB2::run(RenderContext &ctx) {
+    rainbowWithGlitter(ctx);
+    hue += 2;
+    return true;
 }
 
 /**
  * Built-in FastLED rainbow, plus some random sparkly glitter.
  */
-void FxB::rainbowWithGlitter() {
-    rainbow();
-    addGlitter(80);
+void FxB::rainbowWithGlitter(RenderContext &ctx) {
+    rainbow(ctx);
+    addGlitter(ctx, 80);
 }
 
-void FxB::addGlitter(fract8 chanceOfGlitter) {
+void FxB::addGlitter(RenderContext &ctx, fract8 chanceOfGlitter) {
     if (random8() < chanceOfGlitter) {
-        leds[random16(NUM_PIXELS)] += CRGB::White;
+        ctx.target[random16(ctx.target.size())] += CRGB::White;
     }
 }
 
@@ -98,43 +98,60 @@ uint8_t FxB2::selectionWeight() const {
     return 40;
 }
 
+uint16_t FxB2::frameBudget() const {
+    return 60;
+}
+
 //FXB3
 FxB3::FxB3() : LedEffect(fxb3Desc) {}
 
 void FxB3::setup() {
     LedEffect::setup();
     hue = 0;
-    brightness = 148;
+    brightness = 199;
     transEffect.prepare(random8());
 }
 
-void FxB3::run() {
-    if (mode == TurnOff) {
-        if (transEffect.transition())
-            mode = Chase;
-        else
-            return;
-    }
-
-    EVERY_N_MILLISECONDS(50) {
-        fxb_confetti();
-    }
+bool FxB3::run(RenderContext &ctx) {
+    fxb_confetti(ctx);
     EVERY_N_SECONDS(133) {
-        if (countPixelsBrighter(&tpl) > 10)
+        //more than 10 lit pixels in the template - turn the strip off through a wind down, see nextState
+        if (countPixelsBrighter(&ctx.tpl) > 10) {
             mode = TurnOff;
+            desiredState(WindDown);
+        }
+    }
+    return true;
+}
+
+void FxB3::windDownPrep() {
+    //the turn off runs the transition prepared at setup over the confetti as is
+    if (mode != TurnOff)
+        LedEffect::windDownPrep();
+}
+
+/**
+ * The turn off is a wind down of the effect - the transition works on (and shows) the strip itself. Once the strip is off the effect resumes
+ * running, rather than moving on to the transition break
+ */
+void FxB3::nextState() {
+    if ((state == WindDown) && (mode == TurnOff)) {
+        mode = Chase;
+        state = Running;
+        return;
     }
+    LedEffect::nextState();
 }
 
-void FxB::fxb_confetti() {
+void FxB::fxb_confetti(RenderContext &ctx) {
     // Random colored speckles that blink in and fade smoothly.
-    tpl.fadeToBlackBy(10);
-    uint16_t pos = random16(tpl.size());
+    ctx.tpl.fadeToBlackBy(10);
+    uint16_t pos = random16(ctx.tpl.size());
     if (paletteFactory.isHolidayLimitedHue())
-        tpl[pos] += ColorFromPalette(palette, hue + random8(64));
+        ctx.tpl[pos] += ColorFromCache(ctx.palette, hue + random8(64));
     else
-        tpl[pos] += CHSV(hue + random8(64), 200, 255);
-    replicateSet(tpl, others);
-    FastLED.show(stripBrightness);
+        ctx.tpl[pos] += CHSV(hue + random8(64), 200, 255);
+    replicateSet(ctx.tpl, ctx.others);
     hue += 2;
 }
 
@@ -148,3 +165,7 @@ uint8_t FxB3::selectionWeight() const {
     return 24;
 }
 
+uint16_t FxB3::frameBudget() const {
+    return 50;
+}
+
@@ -28,42 +28,41 @@ void FxC::fxRegister() {
  * Date: January, 2017
  * This sketch demonstrates how to blend between two animations running at the same time.
  */
-FxC1::FxC1() : LedEffect(fxc1Desc), setA(frame(0, FRAME_SIZE-1)), setB(leds, FRAME_SIZE) {
+FxC1::FxC1() : LedEffect(fxc1Desc) {
 }
 
 void FxC1::setup() {
     LedEffect::setup();
-    brightness = 176;
+    brightness = 215;
+    layerA = compositor.addLayer(tpl.size());
 }
 
-void FxC1::run() {
-    animationA();
-    animationB();
-    CRGBSet others(leds, setB.size(), NUM_PIXELS);
+bool FxC1::run(RenderContext &ctx) {
+    animationA(ctx);
+    animationB(ctx);
 
-    //combine all into setB (it is backed by the strip)
-    uint8_t ratio = beatsin8(2);
-    for (uint16_t x = 0; x < setB.size(); x++) {
-        setB[x] = blend(setA[x], setB[x], ratio);
-    }
-    replicateSet(setB, others);
-
-    FastLED.show(stripBrightness);
+    //combine all into the template (animation B) - animation A layered on top, with an opacity oscillating in time
+    compositor.setOpacity(layerA, 255 - beatsin8(2));
+    compositor.composite(ctx.tpl);
+    replicateSet(ctx.tpl, ctx.others);
+    return true;
 }
 
-void FxC1::animationA() {
+void FxC1::animationA(RenderContext &ctx) {
+    CRGBSet setA = compositor.layer(layerA);
     for (uint16_t x = 0; x<setA.size(); x++) {
-        uint8_t clrIndex = (millis() / 10) + (x * 12);    // speed, length
+        uint8_t clrIndex = (ctx.now / 10) + (x * 12);    // speed, length
         if (clrIndex > 128) clrIndex = 0;
-        setA[x] = ColorFromPalette(palette, clrIndex, dim8_raw(clrIndex << 1), LINEARBLEND);
+        setA[x] = ColorFromCache(ctx.palette, clrIndex, clrIndex << 1, LINEARBLEND);
     }
 }
 
-void FxC1::animationB() {
+void FxC1::animationB(RenderContext &ctx) {
+    CRGBSet &setB = ctx.tpl;
     for (uint16_t x = 0; x<setB.size(); x++) {
-        uint8_t clrIndex = (millis() / 5) - (x * 12);    // speed, length
+        uint8_t clrIndex = (ctx.now / 5) - (x * 12);    // speed, length
         if (clrIndex > 128) clrIndex = 0;
-        setB[x] = ColorFromPalette(palette, 255-clrIndex, dim8_raw(clrIndex << 1), LINEARBLEND);
+        setB[x] = ColorFromCache(ctx.palette, 255-clrIndex, clrIndex << 1, LINEARBLEND);
     }
 }
 
@@ -74,6 +73,10 @@ bool FxC1::windDown() {
 uint8_t FxC1::selectionWeight() const {
     return 35;
 }
+
+uint16_t FxC1::frameBudget() const {
+    return 30;
+}
 //Fx C2
 /**
  * blur
@@ -92,7 +95,8 @@ FxC2::FxC2() : LedEffect(fxc2Desc) {}
 //    LedEffect::setup();
 //}
 
-void FxC2::run() {
+bool FxC2::run(RenderContext &ctx) {
+    CRGBSet &tpl = ctx.tpl;
     uint8_t blurAmount = dim8_raw( beatsin8(3,64, 192) );       // A sinewave at 3 Hz with values ranging from 64 to 192.
     tpl.blur1d(blurAmount);                        // Apply some blurring to whatever's already on the strip, which will eventually go black.
 
@@ -101,14 +105,14 @@ void FxC2::run() {
     uint16_t  k = beatsin16(  5, 0, tpl.size()-1);
 
     // The color of each point shifts over time, each at a different speed.
-    uint16_t ms = millis();
-    leds[(i+j)/2] = paletteFactory.isHolidayLimitedHue() ? ColorFromPalette(palette, ms/29) : CHSV( ms / 29, 200, 255);
-    leds[(j+k)/2] = paletteFactory.isHolidayLimitedHue() ? ColorFromPalette(palette, ms/41) : CHSV( ms / 41, 200, 255);
-    leds[(k+i)/2] = paletteFactory.isHolidayLimitedHue() ? ColorFromPalette(palette, ms/73) : CHSV( ms / 73, 200, 255);
-    leds[(k+i+j)/3] = paletteFactory.isHolidayLimitedHue() ? ColorFromPalette(palette, ms/53) : CHSV( ms / 53, 200, 255);
-
-    replicateSet(tpl, others);
-    FastLED.show(stripBrightness);
+    uint16_t ms = ctx.now;
+    tpl[(i+j)/2] = paletteFactory.isHolidayLimitedHue() ? ColorFromCache(ctx.palette, ms/29) : CHSV( ms / 29, 200, 255);
+    tpl[(j+k)/2] = paletteFactory.isHolidayLimitedHue() ? ColorFromCache(ctx.palette, ms/41) : CHSV( ms / 41, 200, 255);
+    tpl[(k+i)/2] = paletteFactory.isHolidayLimitedHue() ? ColorFromCache(ctx.palette, ms/73) : CHSV( ms / 73, 200, 255);
+    tpl[(k+i+j)/3] = paletteFactory.isHolidayLimitedHue() ? ColorFromCache(ctx.palette, ms/53) : CHSV( ms / 53, 200, 255);
+
+    replicateSet(tpl, ctx.others);
+    return true;
 }
 
 void FxC2::windDownPrep() {
@@ -119,3 +123,7 @@ uint8_t FxC2::selectionWeight() const {
     return 5;
 }
 
+uint16_t FxC2::frameBudget() const {
+    return 30;
+}
+
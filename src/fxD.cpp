@@ -25,20 +25,17 @@ void FxD::fxRegister() {
 // Fx D3
 void FxD3::setup() {
     LedEffect::setup();
-    targetPalette = paletteFactory.mainPalette();
-    palette = paletteFactory.secondaryPalette();
+    paletteBlender.setTarget(paletteFactory.mainPalette());
+    paletteBlender.setPalette(paletteFactory.secondaryPalette());
+    paletteBlender.blendOver(paletteBlendTime);
     monoColor = random8(224);   //colors above this index in the Halloween palette are black
 }
 
-void FxD3::run() {
-    EVERY_N_MILLISECONDS(50) {                                  // FastLED based non-blocking delay to update/display the sequence.
-        plasma();
-        FastLED.show(stripBrightness);
-    }
+bool FxD3::run(RenderContext &ctx) {
+    plasma(ctx);
 
-    EVERY_N_SECONDS(5) {
-        nblendPaletteTowardPalette(palette, targetPalette, maxChanges);
-    }
+    if (!paletteBlender.isConverged())
+        paletteBlender.update();
 
     if (paletteFactory.isHolidayLimitedHue()) {
         EVERY_N_SECONDS(45) {
@@ -46,22 +43,23 @@ void FxD3::run() {
         }
     } else {
         EVERY_N_SECONDS(30) {
-            targetPalette = PaletteFactory::randomPalette(random8());
+            paletteBlender.setTarget(PaletteFactory::randomPalette(random8()));
+            paletteBlender.blendOver(paletteBlendTime);
         }
     }
-
+    return true;
 }
 
-void FxD3::plasma() {
+void FxD3::plasma(RenderContext &ctx) {
     uint8_t thisPhase = beatsin8(6,-64,64);                           // Setting phase change for a couple of waves.
     uint8_t thatPhase = beatsin8(7,-64,64);
 
-    for (int k=0; k<NUM_PIXELS; k++) {                              // For each of the LED's in the strand, set a localBright based on a wave as follows:
+    for (int k=0; k<ctx.target.size(); k++) {                              // For each of the LED's in the strand, set a localBright based on a wave as follows:
         uint8_t colorIndex = cubicwave8((k*23)+thisPhase)/2 + cos8((k*15)+thatPhase)/2;           // Create a wave and add a phase change and add another wave with its own phase change.. Hey, you can even change the frequencies if you wish.
         uint8_t thisBright = qsuba(colorIndex, beatsin8(7,0,96));              // qsub gives it a bit of 'black' dead space by setting sets a minimum value. If colorIndex < current value of beatsin8(), then bright = 0. Otherwise, bright = colorIndex..
         //plasma becomes slime during Halloween (single color morphing mass)
         uint8_t clr = paletteFactory.isHolidayLimitedHue() ? monoColor : colorIndex;
-        leds[k] = ColorFromPalette(palette, clr, thisBright, LINEARBLEND);  // Let's now add the foreground colour.
+        ctx.target[k] = ColorFromCache(ctx.palette, clr, thisBright, LINEARBLEND);  // Let's now add the foreground colour.
     }
 }
 
@@ -75,6 +73,10 @@ uint8_t FxD3::selectionWeight() const {
     return 24;
 }
 
+uint16_t FxD3::frameBudget() const {
+    return 50;
+}
+
 // Fx D4
 FxD4::FxD4() : LedEffect(fxd4Desc) {}
 
@@ -84,7 +86,7 @@ void FxD4::setup() {
     hueDiff = 1;
 }
 
-void FxD4::run() {
+bool FxD4::run(RenderContext &ctx) {
     static uint8_t secSlot = 0;
 
     EVERY_N_SECONDS(5) {
@@ -92,10 +94,9 @@ void FxD4::run() {
         secSlot = inc(secSlot, 1, 15);
     }
 
-    EVERY_N_MILLISECONDS(50) {
-        rainbow_march();
-        FastLED.show(stripBrightness);
-    }
+    rainbow_march(ctx);
+    ctx.templateSize = ctx.tpl.size();      //the output stage repeats the template over the strip
+    return true;
 }
 
 void FxD4::update_params(uint8_t slot) {
@@ -110,17 +111,16 @@ void FxD4::update_params(uint8_t slot) {
     }
 }
 
-void FxD4::rainbow_march() {
+void FxD4::rainbow_march(RenderContext &ctx) {
     if (dirFwd) hue += rot; else hue-= rot;                                       // I could use signed math, but 'dirFwd' works with other routines.
     if (paletteFactory.isHolidayLimitedHue())
-        tpl.fill_gradient_RGB(ColorFromPalette(palette, hue, brightness),
-          ColorFromPalette(palette, hue+128, brightness),
-          ColorFromPalette(palette, 255-hue, brightness));
+        ctx.tpl.fill_gradient_RGB(ColorFromCache(ctx.palette, hue, brightness),
+          ColorFromCache(ctx.palette, hue+128, brightness),
+          ColorFromCache(ctx.palette, 255-hue, brightness));
     else {
-        tpl.fill_rainbow(hue, hueDiff);           // I don't change hueDiff on the fly as it's too fast near the end of the strip.
-        tpl.nscale8(brightness);
+        ctx.tpl.fill_rainbow(hue, hueDiff);           // I don't change hueDiff on the fly as it's too fast near the end of the strip.
+        ctx.tpl.nscale8(brightness);
     }
-    replicateSet(tpl, others);
 }
 
 bool FxD4::windDown() {
@@ -131,38 +131,40 @@ uint8_t FxD4::selectionWeight() const {
     return 18;
 }
 
+uint16_t FxD4::frameBudget() const {
+    return 50;
+}
+
 // Fx D5
 FxD5::FxD5() : LedEffect(fxd5Desc) {}
 
 void FxD5::setup() {
     LedEffect::setup();
+    paletteBlender.blendOver(paletteBlendTime);
 }
 
-void FxD5::run() {
-    EVERY_N_SECONDS(2) {
-        nblendPaletteTowardPalette(palette, targetPalette, maxChanges);
-    }
-    EVERY_N_MILLISECONDS(100) {
-        ripples();
-        FastLED.show(stripBrightness);
-    }
+bool FxD5::run(RenderContext &ctx) {
+    if (!paletteBlender.isConverged())
+        paletteBlender.update();
+    ripples(ctx);
+    return true;
 }
 
-void FxD5::ripples() {
-    //fadeToBlackBy(leds, NUM_PIXELS, fade);                             // 8 bit, 1 = slow, 255 = fast
+void FxD5::ripples(RenderContext &ctx) {
+    //fadeToBlackBy(leds, numPixels, fade);                             // 8 bit, 1 = slow, 255 = fast
     for (auto & r : ripplesData) {
         if (random8() > 224 && !r.Alive()) {
-            r.Init(&tpl);
+            r.Init(ctx.tpl);
         }
     }
 
     for (auto & r : ripplesData) {
         if (r.Alive()) {
-            r.Fade();
-            r.Move();
+            r.Fade(ctx.tpl);
+            r.Move(ctx.tpl, ctx.palette);
         }
     }
-    replicateSet(tpl, others);
+    replicateSet(ctx.tpl, ctx.others);
 }
 
 void FxD5::windDownPrep() {
@@ -170,32 +172,31 @@ void FxD5::windDownPrep() {
 }
 
 // ripple structure API
-void ripple::Move() {
+void ripple::Move(CRGBSet &seg, const CRGBPalette16 &pal) {
     if (step == 0) {
-        (*pSeg)[center] = ColorFromPalette(palette, color, rpBright, LINEARBLEND);
+        seg[center] = ColorFromCache(pal, color, rpBright, LINEARBLEND);
     } else if (step < 12) {
-        uint16_t x = (center + step) % pSeg->size();
-        x = (center + step) >= pSeg->size() ? (pSeg->size() - x - 1) : x;        // we want the "wave" to bounce back from the end, rather than start from the other end
-        (*pSeg)[x] += ColorFromPalette(palette, color + 16, rpBright*2/step, LINEARBLEND);       // Simple wrap from Marc Miller
-        x = asub(center, step) % pSeg->size();
-        (*pSeg)[x] += ColorFromPalette(palette, color + 16, rpBright*2/step, LINEARBLEND);
+        uint16_t x = (center + step) % seg.size();
+        x = (center + step) >= seg.size() ? (seg.size() - x - 1) : x;        // we want the "wave" to bounce back from the end, rather than start from the other end
+        seg[x] += ColorFromCache(pal, color + 16, rpBright*2/step, LINEARBLEND);       // Simple wrap from Marc Miller
+        x = asub(center, step) % seg.size();
+        seg[x] += ColorFromCache(pal, color + 16, rpBright*2/step, LINEARBLEND);
     }
     step++;  // Next step.
 }
 
-void ripple::Fade() const {
+void ripple::Fade(CRGBSet &seg) const {
     uint16_t lowEndRipple = qsuba(center, step);
-    uint16_t upEndRipple = capu(center + step, pSeg->size()-1);
-    (*pSeg)(lowEndRipple, upEndRipple).fadeToBlackBy(rpFade);
+    uint16_t upEndRipple = capu(center + step, seg.size()-1);
+    seg(lowEndRipple, upEndRipple).fadeToBlackBy(rpFade);
 }
 
 bool ripple::Alive() const {
     return step < 42;
 }
 
-void ripple::Init(CRGBSet *set) {
-    pSeg = set;
-    center = random8(pSeg->size() / 8, pSeg->size() - pSeg->size() / 8);          // Avoid spawning too close to edge.
+void ripple::Init(const CRGBSet &seg) {
+    center = random8(seg.size() / 8, seg.size() - seg.size() / 8);          // Avoid spawning too close to edge.
     rpBright = random8(192, 255);                                   // upper range of localBright
     color = random8();
     rpFade = random8(25, 80);
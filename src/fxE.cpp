@@ -24,26 +24,25 @@ void FxE4::setup() {
     LedEffect::setup();
     X = Xorig;
     Y = Yorig;
+    paletteBlender.blendOver(paletteBlendTime);
 }
 
-void FxE4::run() {
-    EVERY_N_SECONDS(2) {
-        nblendPaletteTowardPalette(palette, targetPalette, maxChanges);
-    }
+bool FxE4::run(RenderContext &ctx) {
+    if (!paletteBlender.isConverged())
+        paletteBlender.update();
 
     if (!paletteFactory.isHolidayLimitedHue()) {
         EVERY_N_SECONDS(30) {
-            targetPalette = PaletteFactory::randomPalette(random8());
+            paletteBlender.setTarget(PaletteFactory::randomPalette(random8()));
+            paletteBlender.blendOver(paletteBlendTime);
         }
     }
 
-    EVERY_N_MILLISECONDS(50) {
-        serendipitous();
-        FastLED.show(stripBrightness);
-    }
+    serendipitous(ctx);
+    return true;
 }
 
-void FxE4::serendipitous() {
+void FxE4::serendipitous(RenderContext &ctx) {
     //  Xn = X-(Y/2); Yn = Y+(Xn/2);
     //  Xn = X-Y/2;   Yn = Y+Xn/2;
     uint16_t Xn = X-(Y/2); uint16_t Yn = Y+(X/2.1); uint16_t Zn = X + Y*2.3;
@@ -54,11 +53,11 @@ void FxE4::serendipitous() {
     Y = Yn;
 
     index=(sin8(X)+cos8(Y))/2;
-    CRGB newcolor = ColorFromPalette(palette, index, map(Zn, 0, 65535, dimmed*3, brightness), LINEARBLEND);
+    CRGB newcolor = ColorFromCache(ctx.palette, index, map(Zn, 0, 65535, dimmed*3, brightness), LINEARBLEND);
 
-    nblend(tpl[map(X, 0, 65535, 0, tpl.size()-1)], newcolor, 224);    // Try and smooth it out a bit. Higher # means less smoothing.
-    tpl.fadeToBlackBy(16);                    // 8 bit, 1 = slow, 255 = fast
-    replicateSet(tpl, others);
+    nblend(ctx.tpl[map(X, 0, 65535, 0, ctx.tpl.size()-1)], newcolor, 224);    // Try and smooth it out a bit. Higher # means less smoothing.
+    ctx.tpl.fadeToBlackBy(16);                    // 8 bit, 1 = slow, 255 = fast
+    replicateSet(ctx.tpl, ctx.others);
 }
 
 void FxE4::windDownPrep() {
@@ -69,3 +68,7 @@ uint8_t FxE4::selectionWeight() const {
     return 36;
 }
 
+uint16_t FxE4::frameBudget() const {
+    return 50;
+}
+
@@ -0,0 +1,455 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#include "fxbench.h"
+
+#ifdef FX_BENCHMARK
+#include <malloc.h>
+#ifndef ARDUINO
+#include <chrono>
+#endif
+#include "net_setup.h"
+#include "particles.h"
+
+#define BENCH_PRINT_BUF_SIZE    160
+static const uint32_t stackPaint = 0xE25A2EA5;
+
+BenchLedSink benchSink;
+static CRGB benchFrame[MAX_NUM_PIXELS];     //off-screen pixel buffer the effects render into
+static uint32_t renderChecksum = 5381;      //running hash of all the frames the effects rendered off-screen
+static volatile uint32_t allocCount = 0;    //number of allocations through operator new since start
+
+/**
+ * Counting allocator - in benchmark builds every allocation through <code>new</code> is counted, such that the allocations an effect makes
+ * while rendering can be reported next to its heap usage
+ */
+void *operator new(size_t size) {
+    allocCount = allocCount + 1;
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    abort();
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+/**
+ * Monotonic time for the frame measurements
+ * @return time in ns - the board's timer counts microseconds, the host's clock resolves nanoseconds
+ */
+static inline uint64_t nanos() {
+#ifdef ARDUINO
+    return (uint64_t)micros() * 1000;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * Folds the frame pushed into the running checksum and counts it
+ * @param pixels pixel data as prepared by FastLED - brightness scaling and color correction included
+ */
+void BenchLedSink::showPixels(PixelController<RGB> &pixels) {
+    while (pixels.has(1)) {
+        checksum = ((checksum << 5) + checksum) ^ pixels.loadAndScale0();
+        checksum = ((checksum << 5) + checksum) ^ pixels.loadAndScale1();
+        checksum = ((checksum << 5) + checksum) ^ pixels.loadAndScale2();
+        pixels.advanceData();
+        pixels.stepDithering();
+    }
+    frames++;
+}
+
+/**
+ * Formatted print to the serial console - the benchmark report does not depend on logging being enabled
+ * @param fmt printf style format
+ * @param ... format arguments
+ */
+static void benchPrint(const char *fmt, ...) {
+    char buf[BENCH_PRINT_BUF_SIZE];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, BENCH_PRINT_BUF_SIZE, fmt, args);
+    va_end(args);
+    Serial.println(buf);
+}
+
+/**
+ * Paints the stack area below the caller's frame with a known pattern. Must be called from the same function (same stack depth)
+ * as <code>stackHighWater</code>
+ */
+static void __attribute__((noinline)) paintStack() {
+    volatile uint32_t *sp = (volatile uint32_t *)__builtin_frame_address(0);
+    for (uint16_t x = 16; x < BENCH_STACK_PROBE_SIZE/sizeof(uint32_t); x++)
+        *(sp - x) = stackPaint;
+}
+
+/**
+ * Measures how deep the stack has grown below the caller's frame since the last <code>paintStack</code> call
+ * @return peak stack usage in bytes
+ */
+static uint16_t __attribute__((noinline)) stackHighWater() {
+    volatile uint32_t *sp = (volatile uint32_t *)__builtin_frame_address(0);
+    uint16_t x = BENCH_STACK_PROBE_SIZE/sizeof(uint32_t) - 1;
+    while ((x > 16) && (*(sp - x) == stackPaint))
+        x--;
+    return (x + 1) * sizeof(uint32_t);
+}
+
+/**
+ * Runs one effect through a number of frames (or <code>BENCH_MAX_MS_PER_FX</code> time, whichever comes first)
+ * <p>The effect renders off-screen, into <code>benchFrame</code> - the frame times measured are the effect's rendering alone, the output
+ * stage is benchmarked separately. Every frame rendered is folded into <code>renderChecksum</code>.</p>
+ * @param fx the effect to benchmark
+ * @param frames number of frames to render
+ * @return the measurements collected
+ */
+FxBenchResult benchEffect(LedEffect *fx, uint16_t frames) {
+    FxBenchResult res {};
+    const int heapStart = mallinfo().uordblks;
+    const uint32_t allocStart = allocCount;
+    paintStack();
+
+    CRGBSet target(benchFrame, numPixels);
+    CRGBSet frameTpl(benchFrame, tpl.size());
+    CRGBSet frameOthers(benchFrame + tpl.size(), numPixels - tpl.size());
+    target = BKG;
+    fx->setup();
+    const ulong start = millis();
+    ulong lastFrame = start;
+    while ((res.frames < frames) && ((millis() - start) < BENCH_MAX_MS_PER_FX)) {
+        const ulong now = millis();
+        RenderContext ctx {target, frameTpl, frameOthers, palette, now, (uint16_t)min(now - lastFrame, 0xFFFFul), stripBrightness, 0, nullptr};
+        lastFrame = now;
+        const uint64_t frameStart = nanos();
+        const bool rendered = fx->run(ctx);
+        const auto dur = (uint32_t)(nanos() - frameStart);
+        //effects pace themselves - the calls that did not render a frame are not counted
+        if (rendered) {
+            res.frames++;
+            res.totalTime += dur;
+            res.maxFrameTime = max(res.maxFrameTime, dur);
+            //the output stage expands a template as it shows the frame - the off-screen frame is expanded here, outside the frame time
+            if ((ctx.templateSize > 0) && (ctx.templateSize < target.size())) {
+                CRGBSet frameRest(benchFrame + ctx.templateSize, target.size() - ctx.templateSize);
+                replicateSet(CRGBSet(benchFrame, ctx.templateSize), frameRest);
+            }
+            for (uint16_t x = 0; x < target.size(); x++) {
+                renderChecksum = ((renderChecksum << 5) + renderChecksum) ^ target[x].r;
+                renderChecksum = ((renderChecksum << 5) + renderChecksum) ^ target[x].g;
+                renderChecksum = ((renderChecksum << 5) + renderChecksum) ^ target[x].b;
+            }
+        }
+        yield();
+    }
+
+    res.peakStack = stackHighWater();
+    res.heapDelta = mallinfo().uordblks - heapStart;
+    res.allocations = allocCount - allocStart;
+    return res;
+}
+
+/**
+ * Whether an effect rendered all its frames within budget
+ * @param fx the effect benchmarked
+ * @param res the measurements collected
+ * @return true if the longest frame fits in the effect's frame budget
+ */
+bool benchWithinBudget(const LedEffect *fx, const FxBenchResult &res) {
+    return res.maxFrameTime <= fx->frameBudget()*1000000ull;
+}
+
+/**
+ * Floating point particle - the representation the fireworks effect used before the fixed point particle system; reference for the kernels comparison
+ */
+struct FloatParticle {
+    float pos;
+    float velocity;
+};
+
+/**
+ * Compares the cost of one frame of particle physics (move, bound, gravity, decay) in floating point and in fixed point math
+ * - see <code>particlesStep</code>. Both kernels run on the same initial conditions; the positions they end with are reported as a sanity check.
+ */
+static void benchParticles() {
+    static FloatParticle flParticles[BENCH_PARTICLES];
+    static Particle fxParticles[BENCH_PARTICLES];
+    for (uint16_t x = 0; x < BENCH_PARTICLES; x++) {
+        const uint16_t vel = random16(0, 20000);
+        flParticles[x].pos = FRAME_SIZE/2;
+        flParticles[x].velocity = (float(vel) / 10000.0f) - 1.0f;
+        fxParticles[x].pos = toFix16(FRAME_SIZE/2);
+        fxParticles[x].velocity = fix16Ratio(vel, 10000) - FIX16_ONE;
+    }
+
+    float flGravity = -.004f;
+    ulong start = micros();
+    for (uint16_t s = 0; s < BENCH_PARTICLE_STEPS; s++) {
+        for (auto &p : flParticles) {
+            p.pos = constrain(p.pos + p.velocity, 0, float(FRAME_SIZE-1));
+            p.velocity += flGravity;
+        }
+        flGravity *= 0.985f;
+    }
+    const ulong flTime = micros() - start;
+
+    DecayingFix16 fxGravity(TO_FIX16(-.004f));
+    start = micros();
+    for (uint16_t s = 0; s < BENCH_PARTICLE_STEPS; s++) {
+        particlesStep(fxParticles, BENCH_PARTICLES, fxGravity.value(), toFix16(FRAME_SIZE-1));
+        fxGravity.decay(FIX16_DECAY(.985f));
+    }
+    const ulong fxTime = micros() - start;
+
+    benchPrint("particles=%d steps=%d float=%uus fixed=%uus speedup=%u.%02ux pos[0] float=%d fixed=%d", BENCH_PARTICLES, BENCH_PARTICLE_STEPS,
+               flTime, fxTime, fxTime ? flTime/fxTime : 0, fxTime ? (flTime*100/fxTime)%100 : 0, int(flParticles[0].pos), fix16ToInt(fxParticles[0].pos));
+}
+
+/**
+ * Ease Out Quad in floating point - the implementation replaced by the easing tables; reference for the easing comparison
+ */
+static uint16_t __attribute__((noinline)) floatEaseOutQuad(const uint16_t x, const uint16_t lim) {
+    auto limf = float(lim);
+    float xf = float(x)/limf;
+    return uint16_t((1 - (1-xf)*(1-xf))*limf);
+}
+
+/**
+ * Ease Out Bounce in floating point - the implementation replaced by the easing tables; reference for the easing comparison
+ */
+static uint16_t __attribute__((noinline)) floatEaseOutBounce(const uint16_t x, const uint16_t lim) {
+    const float d1 = 2.75f;
+    const float n1 = 7.5625f;
+    float xf = ((float)x)/(float)lim;
+    float res;
+    if (xf < 1/d1)
+        res = n1*xf*xf;
+    else if (xf < 2/d1) {
+        float xf1 = xf - 1.5f/d1;
+        res = n1*xf1*xf1 + 0.75f;
+    } else if (xf < 2.5f/d1) {
+        float xf1 = xf - 2.25f/d1;
+        res = n1*xf1*xf1 + 0.9375f;
+    } else {
+        float xf1 = xf - 2.625f/d1;
+        res = n1*xf1*xf1 + 0.984375f;
+    }
+    return (uint16_t)(res * (float)lim);
+}
+
+/**
+ * Compares the cost per call and the results of an easing curve in floating point against the table based <code>ease</code>
+ * @param name label of the curve in the report
+ * @param curve table based easing curve
+ * @param floatEase the floating point reference
+ */
+static void benchEase(const char *name, const EaseCurve curve, uint16_t (*floatEase)(uint16_t, uint16_t)) {
+    volatile uint16_t sink = 0;
+    ulong start = micros();
+    for (uint16_t x = 0; x <= BENCH_EASE_RANGE; x++)
+        sink = floatEase(x, BENCH_EASE_RANGE);
+    const ulong flTime = micros() - start;
+    start = micros();
+    for (uint16_t x = 0; x <= BENCH_EASE_RANGE; x++)
+        sink = ease(curve, x, BENCH_EASE_RANGE);
+    const ulong tblTime = micros() - start;
+    uint16_t maxErr = 0;
+    for (uint16_t x = 0; x <= BENCH_EASE_RANGE; x++)
+        maxErr = max(maxErr, (uint16_t)abs(int32_t(floatEase(x, BENCH_EASE_RANGE)) - int32_t(ease(curve, x, BENCH_EASE_RANGE))));
+    (void)sink;
+    const uint32_t calls = BENCH_EASE_RANGE + 1;
+    benchPrint("%-13s calls=%u float=%uns/call table=%uns/call maxErr=%u/%u", name, calls, flTime*1000/calls, tblTime*1000/calls, maxErr, BENCH_EASE_RANGE);
+}
+
+/**
+ * Compares replicating the template over the rest of a strip pixel by pixel (the replicateSet loop used before the block copies) against
+ * the block copies of <code>replicateSet</code>. Both must produce the same pixels.
+ */
+static void benchReplicate() {
+    static CRGB loopStrip[MAX_NUM_PIXELS], blockStrip[MAX_NUM_PIXELS];
+    const uint16_t szTpl = tpl.size();
+    for (uint16_t x = 0; x < szTpl; x++)
+        loopStrip[x] = blockStrip[x] = CRGB(random8(), random8(), random8());
+    CRGBSet loopTpl(loopStrip, szTpl), loopOthers(loopStrip + szTpl, numPixels - szTpl);
+    CRGBSet blockTpl(blockStrip, szTpl), blockOthers(blockStrip + szTpl, numPixels - szTpl);
+
+    ulong start = micros();
+    for (uint16_t r = 0; r < BENCH_REPLICATE_ROUNDS; r++) {
+        uint16_t x = 0;
+        for (auto &y : loopOthers) {
+            y = loopTpl[x];
+            incr(x, 1, szTpl);
+        }
+    }
+    const ulong loopTime = micros() - start;
+    start = micros();
+    for (uint16_t r = 0; r < BENCH_REPLICATE_ROUNDS; r++)
+        replicateSet(blockTpl, blockOthers);
+    const ulong blockTime = micros() - start;
+
+    benchPrint("replicateSet  template=%d strip=%d loop=%uus/frame block=%uus/frame %s", szTpl, numPixels,
+               loopTime/BENCH_REPLICATE_ROUNDS, blockTime/BENCH_REPLICATE_ROUNDS, memcmp(loopStrip, blockStrip, sizeof(loopStrip)) == 0 ? "MATCH" : "MISMATCH");
+}
+
+/**
+ * Setup the effects engine against the recording LED sink - see <code>ledStripInit</code>. Runs once, further calls are no-ops
+ */
+void bench_setup() {
+    static bool initialized = false;
+    if (initialized)
+        return;
+    initialized = true;
+    if (!Serial) {
+        Serial.begin(115200);
+        while (!Serial) {}
+    }
+    fx_setup();
+}
+
+/**
+ * Lays the strip out over a number of pixels, split evenly across the room segments - for measuring the effects over strip sizes other than
+ * the board's. Effects pick the new layout up on their next setup
+ * @param pixels number of pixels on the strip, within [<code>MIN_NUM_PIXELS</code>, <code>MAX_NUM_PIXELS</code>]
+ * @return true if the layout is active; false if it is not valid (active layout unchanged)
+ */
+bool benchLayout(const uint16_t pixels) {
+    SegmentDef segs[SEG_COUNT];
+    uint16_t start = 0;
+    for (uint8_t s = 0; s < SEG_COUNT; s++) {
+        const auto end = (uint16_t)((uint32_t)pixels * (s+1) / SEG_COUNT);
+        segs[s] = {start, (uint16_t)(end-1), defaultLayout[s].reversed, defaultLayout[s].perimeter};
+        start = end;
+    }
+    if (!setLayout(segs, pixels))
+        return false;
+    stripOutput.setTemplate(0);
+    applyLayout();
+    stripOutput.mapOutputs();
+    benchSink.setLeds(stripOutput.wireBuffer(), numPixels);
+    shuffleIndexes(stripShuffleIndex, numPixels);
+    return true;
+}
+
+/**
+ * Measures the dithering pass of the second core, over the active strip and over the largest strip supported. While dithering, the pass runs
+ * ahead of every push, up to 100 times a second - together with the wire time of the longest output it must fit in the dithering frame time
+ */
+static void benchDither() {
+    static CRGB16 src[MAX_NUM_PIXELS];
+    static CRGB dest[MAX_NUM_PIXELS];
+    static uint8_t residual[MAX_NUM_PIXELS*3];
+    for (uint16_t x = 0; x < MAX_NUM_PIXELS; x++)
+        src[x] = CRGB16(random16(0xFF00), random16(0xFF00), random16(0xFF00));
+    const uint16_t sizes[] = {numPixels, MAX_NUM_PIXELS};
+    for (uint16_t sz : sizes) {
+        const ulong start = micros();
+        for (uint16_t r = 0; r < BENCH_DITHER_ROUNDS; r++)
+            StripOutput::ditherFrame(dest, src, residual, sz);
+        const uint32_t ditherTime = (micros() - start) / BENCH_DITHER_ROUNDS;
+        const uint32_t pushTime = ditherTime + StripOutput::wireTime((sz + LED_OUTPUTS - 1) / LED_OUTPUTS);
+        benchPrint("ditherFrame   pixels=%u dither=%uus/frame push=%uus/frame outputs=%d %s", sz, ditherTime, pushTime, LED_OUTPUTS,
+                   pushTime <= DITHER_FRAME_TIME_US ? "FITS" : "OVER");
+    }
+}
+
+/**
+ * Measures the shifts of the whole strip (e.g. wipe transitions) - moving the pixels of a color set against moving the origin of a ring,
+ * over the active strip and over the largest strip supported. The ring's time includes linearizing it once at the end, which the output stage
+ * otherwise folds into its copy through the output curve. Both are fed the same colors and must end up with the same pixels
+ */
+static void benchShift() {
+    static CRGB setBuf[MAX_NUM_PIXELS];
+    static CRGB ringBuf[MAX_NUM_PIXELS];
+    const uint16_t sizes[] = {numPixels, MAX_NUM_PIXELS};
+    for (uint16_t sz : sizes) {
+        for (uint16_t x = 0; x < sz; x++)
+            setBuf[x] = ringBuf[x] = CRGB(random8(), random8(), random8());
+        CRGBSet set(setBuf, sz);
+        RingSet ring(ringBuf, sz);
+        ulong start = micros();
+        for (uint16_t r = 0; r < BENCH_SHIFT_ROUNDS; r++) {
+            if (r & 0x01)
+                shiftLeft(set, CHSV(r, 255, 255));
+            else
+                shiftRight(set, CHSV(r, 255, 255));
+        }
+        const uint32_t setTime = micros() - start;
+        start = micros();
+        for (uint16_t r = 0; r < BENCH_SHIFT_ROUNDS; r++) {
+            if (r & 0x01)
+                shiftLeft(ring, CHSV(r, 255, 255));
+            else
+                shiftRight(ring, CHSV(r, 255, 255));
+        }
+        ring.linearize();
+        const uint32_t ringTime = micros() - start;
+        const bool same = memcmp(setBuf, ringBuf, sz * sizeof(CRGB)) == 0;
+        benchPrint("shift         pixels=%u set=%uus ring=%uus over %d shifts %s", sz, setTime, ringTime, BENCH_SHIFT_ROUNDS, same ? "MATCH" : "DIFF");
+    }
+}
+
+/**
+ * Measures the crossfade pass of the output stage, over the active strip and over the largest strip supported. While effects crossfade, the
+ * pass runs on every frame of the incoming effect - its time adds to the effect's frame time, reported below against the frame budget
+ */
+static void benchCrossfade() {
+    static CRGB16 from[MAX_NUM_PIXELS];
+    static CRGB16 dest[MAX_NUM_PIXELS];
+    for (uint16_t x = 0; x < MAX_NUM_PIXELS; x++) {
+        from[x] = CRGB16(random16(0xFF00), random16(0xFF00), random16(0xFF00));
+        dest[x] = CRGB16(random16(0xFF00), random16(0xFF00), random16(0xFF00));
+    }
+    const uint16_t sizes[] = {numPixels, MAX_NUM_PIXELS};
+    for (uint16_t sz : sizes) {
+        uint32_t sums[3] {};
+        const ulong start = micros();
+        for (uint16_t r = 0; r < BENCH_CROSSFADE_ROUNDS; r++)
+            StripOutput::crossfadeFrame(dest, from, sz, r * (0xFFFF / BENCH_CROSSFADE_ROUNDS), sums);
+        const uint32_t fadeTime = (micros() - start) / BENCH_CROSSFADE_ROUNDS;
+        benchPrint("crossfade     pixels=%u blend=%uus/frame added to the incoming effect's frames", sz, fadeTime);
+    }
+}
+
+/**
+ * Runs every registered effect through the benchmark once and reports the frame timings over serial. An effect whose longest frame
+ * exceeds its frame budget fails the benchmark.
+ */
+void bench_run() {
+    static bool done = false;
+    if (done) {
+        delay(1000);
+        return;
+    }
+    benchPrint("=== Effects benchmark: %d effects, %d pixels, %d frames per effect ===", fxRegistry.size(), numPixels, BENCH_FRAMES_PER_FX);
+    for (uint8_t x = 0; x < stripOutput.outputCount(); x++) {
+        const LedOutput &out = stripOutput.output(x);
+        benchPrint("output %d pin=%d pixels=%u estimated wire time=%uus", x, out.pin, out.size, StripOutput::wireTime(out.size));
+    }
+    benchPrint("static RAM    output stage=%uB pixel buffers=%uB effects frame=%uB - sized for %d pixels", (uint32_t)sizeof(StripOutput),
+               (uint32_t)sizeof(leds), (uint32_t)sizeof(frame), MAX_NUM_PIXELS);
+    benchParticles();
+    benchEase("easeOutQuad", EaseOutQuad, floatEaseOutQuad);
+    benchEase("easeOutBounce", EaseOutBounce, floatEaseOutBounce);
+    benchReplicate();
+    benchDither();
+    benchShift();
+    benchCrossfade();
+    uint16_t failCount = 0;
+    benchForEachEffect([&failCount](LedEffect *fx) {
+        FxBenchResult res = benchEffect(fx);
+        const auto avgFrameTime = (uint32_t)(res.frames ? res.totalTime / res.frames : 0);
+        const bool pass = benchWithinBudget(fx, res);
+        if (!pass)
+            failCount++;
+        benchPrint("%-5s frames=%4u avg=%9uns max=%9uns budget=%4ums heap=%+5dB allocs=%3u stack=%4uB %s", fx->name(), res.frames,
+                   avgFrameTime, res.maxFrameTime, fx->frameBudget(), res.heapDelta, res.allocations, res.peakStack, pass ? "PASS" : "FAIL");
+    });
+    benchPrint("=== Effects benchmark %s: %d effect(s) over frame budget, rendered frames checksum %08X, pushed frames checksum %08X ===",
+               failCount ? "FAILED" : "PASSED", failCount, renderChecksum, benchSink.checksum);
+    stateLED(failCount ? CLR_SETUP_ERROR : CLR_ALL_OK);
+    done = true;
+}
+
+#endif //FX_BENCHMARK
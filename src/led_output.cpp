@@ -0,0 +1,663 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#include "led_output.h"
+#include "easing.h"
+#include <pico/multicore.h>
+#include <hardware/timer.h>
+#include <algorithm>
+
+StripOutput stripOutput;
+static constexpr uint8_t outputPins[] = LED_OUTPUT_PINS;
+static constexpr uint16_t outputStarts[] = LED_OUTPUT_STARTS;
+static_assert(LED_OUTPUTS >= 1 && LED_OUTPUTS <= MAX_LED_OUTPUTS, "LED_OUTPUTS must be between 1 and MAX_LED_OUTPUTS");
+static_assert(arrSize(outputPins) == LED_OUTPUTS && arrSize(outputStarts) == LED_OUTPUTS, "LED_OUTPUT_PINS and LED_OUTPUT_STARTS must list LED_OUTPUTS entries");
+
+/**
+ * Starts the strip pushing loop on the second core. Must be called after the FastLED controller has been registered and before
+ * any frame is shown
+ */
+void StripOutput::begin() {
+    setGamma(OUTPUT_GAMMA);
+    multicore_launch_core1(pushLoop);
+}
+
+/**
+ * Second core - picks up the frame handed over by <code>show</code>, waiting for it if needed
+ * @param timeout max time to wait, in us; <code>UINT32_MAX</code> waits indefinitely
+ * @param msg the hand-over message of the frame picked up
+ * @return whether a frame has been picked up within the timeout
+ */
+bool __not_in_flash_func(StripOutput::pickFrame)(const uint32_t timeout, uint32_t &msg) {
+    const uint32_t start = time_us_32();
+    while (!(stripOutput.handoff & FRAME_PENDING)) {
+        if (timeout == UINT32_MAX)
+            __WFE();    //woken up by show's event
+        else if ((time_us_32() - start) >= timeout)
+            return false;
+    }
+    msg = stripOutput.handoff;
+    __DMB();    //front buffer reads come after the hand-over
+    stripOutput.handoff = 0;    //frame picked up - the other front buffer is free for the next frame
+    return true;
+}
+
+/**
+ * Second core loop - waits for a frame to be handed over, converts it to 8 bit channels (dithered or rounded) into the wire buffer and
+ * shifts it out to the strip. A dithered frame is dithered and pushed again, every <code>DITHER_FRAME_TIME_US</code>, until the next frame
+ * is handed over or it has settled - after <code>DITHER_SETTLE_FRAMES</code> pushes it is pushed once more, rounded, and held.
+ * <p>Only the FastLED controller runs on this core, no RTOS services are available here - hence the pico SDK timer primitives. The loop
+ * runs from RAM and the core is a flash lockout victim: flash writes on the first core pause it, rather than have it fetch code from
+ * flash while flash is being written</p>
+ */
+void __not_in_flash_func(StripOutput::pushLoop)() {
+    multicore_lockout_victim_init();
+    uint32_t msg = 0;
+    pickFrame(UINT32_MAX, msg);
+    while (true) {
+        const CRGB16 *src = stripOutput.front[msg & 0x01];
+        uint8_t *residual = (msg & FRAME_DITHER) ? stripOutput.residual : nullptr;
+        uint16_t pushes = 0;
+        bool next = false;
+        while (!next) {
+            if (residual && (++pushes > DITHER_SETTLE_FRAMES))
+                residual = nullptr;     //the frame has settled - its rounded values are pushed and held
+            const uint32_t start = time_us_32();
+            ditherFrame(stripOutput.wire, src, residual, numPixels);
+            FastLED.show(255);      //brightness is already applied by the output curve
+            const uint32_t elapsed = time_us_32() - start;
+            stripOutput.showStats.record(elapsed);
+            next = pickFrame(residual ? (elapsed < DITHER_FRAME_TIME_US ? DITHER_FRAME_TIME_US - elapsed : 0) : UINT32_MAX, msg);
+        }
+    }
+}
+
+/**
+ * Pushes the current frame to the strip using the FastLED global brightness
+ */
+void StripOutput::show() {
+    show(FastLED.getBrightness());
+}
+
+/**
+ * Hands the current frame over to the second core for pushing to the strip - unless it is identical with the last frame pushed
+ * <p>If the previous frame has not been picked up yet by the second core, this call waits (yielding) for it</p>
+ * @param bright brightness to use for this frame
+ */
+void StripOutput::show(uint8_t bright) {
+    frames++;
+    const uint32_t hash = highRes ? frameHash(back16, numPixels * sizeof(CRGB16), bright) :
+            frameHash(leds, (tplSize > 0 ? tplSize : numPixels) * sizeof(CRGB), bright | (ledRing.origin() << 8));
+    if (!forcePush && fadeTime == 0 && hash == lastHash) {
+        skipped++;
+        return;
+    }
+    while (handoff)
+        yield();
+    if (lutDirty || bright != lutBright)
+        buildLut(bright);
+    CRGB16 *dest = front[nextFront];
+    uint32_t sums[3] {};
+    if (highRes)
+        applyLut(dest, back16, numPixels, sums, stats);
+    else {
+        applyLut(dest, leds, tplSize > 0 ? tplSize : numPixels, ledRing.origin(), sums, stats);
+        if (tplSize > 0) {
+            expandTemplate(dest);
+            //the template repeats over the strip - sums and counts are extrapolated from the template's
+            for (auto &sum : sums)
+                sum = (uint64_t)sum * numPixels / tplSize;
+            const uint16_t tplLit = stats.litPixels;
+            stats.litPixels = (uint32_t)tplLit * numPixels / tplSize;
+            stats.totalLuma = (uint64_t)stats.totalLuma * numPixels / tplSize;
+            for (uint8_t s = 0; s < SEG_COUNT; s++)
+                stats.segmentLit[s] = (uint32_t)tplLit * roomLayout[s].size() / tplSize;
+        }
+    }
+    if (fadeTime > 0) {
+        const ulong elapsed = millis() - fadeStart;
+        if (elapsed < fadeTime) {
+            //the power estimate is of the blended frame
+            sums[0] = sums[1] = sums[2] = 0;
+            crossfadeFrame(dest, fadeFrom, numPixels, ease16(CROSSFADE_CURVE, elapsed * 0xFFFF / fadeTime), sums);
+        } else
+            fadeTime = 0;   //crossfade complete - this frame is the incoming effect's alone
+    }
+    limitPower(dest, sums);
+    uint32_t msg = nextFront;
+    if (highRes || (bright > 0 && bright <= DITHER_MAX_BRIGHTNESS))
+        msg |= FRAME_DITHER;
+    lastHash = hash;
+    forcePush = false;
+    __DMB();    //front buffer writes complete before the second core is signaled
+    handoff = msg | FRAME_PENDING;
+    __SEV();
+    nextFront ^= 0x01;
+}
+
+/**
+ * Starts a crossfade - the frame last pushed to the strip is held and blended under the next frames, its weight easing out to nothing over
+ * the crossfade time. Typically called as the effects change: the outgoing effect stops rendering, the incoming effect renders over it
+ * <p>The frame is held in the high resolution pixel buffer - an outgoing effect rendering in high resolution is cut off its buffer (the
+ * mode is disengaged without carrying the pixels over), an incoming one cancels the crossfade as it engages the mode</p>
+ * @param ms crossfade duration, in ms; 0 cancels a crossfade in progress
+ */
+void StripOutput::crossfade(const uint16_t ms) {
+    highRes = false;
+    //the second core only reads the front buffers - the last one handed over is what the strip shows
+    memcpy(fadeFrom, front[nextFront ^ 0x01], numPixels * sizeof(CRGB16));
+    fadeStart = millis();
+    fadeTime = ms;
+}
+
+bool StripOutput::isCrossfading() const {
+    return fadeTime > 0;
+}
+
+/**
+ * Blends two frames - the output curve has been applied to both
+ * @param dest incoming frame, receives the blend
+ * @param from outgoing frame
+ * @param szPixels number of pixels to blend
+ * @param amount weight of the incoming frame - 0 is the outgoing frame alone, 0xFFFF (almost) the incoming frame alone
+ * @param sums per channel sums of the blended values - accumulated into, for the power estimate
+ */
+void StripOutput::crossfadeFrame(CRGB16 *dest, const CRGB16 *from, const uint16_t szPixels, const fract16 amount, uint32_t *sums) {
+    auto *d = (uint16_t *)dest;
+    const auto *f = (const uint16_t *)from;
+    for (uint16_t x = 0; x < szPixels; x++) {
+        for (uint8_t ch = 0; ch < 3; ch++, d++, f++) {
+            *d = *f + (((int32_t)*d - *f) * (amount >> 1) >> 15);     //halved weight keeps the product within 32 bits
+            sums[ch] += *d;
+        }
+    }
+}
+
+/**
+ * Turns off all pixels - both in the pixel buffer and on the strip
+ */
+void StripOutput::clear() {
+    fill_solid(leds, numPixels, BKG);
+    ledRing.linearize();
+    invalidate();
+    show();
+}
+
+/**
+ * Ensures the next frame is pushed to the strip even if identical with the previous - needed when the strip's content has been changed
+ * outside of this output stage, or the color correction/temperature settings have changed
+ */
+void StripOutput::invalidate() {
+    forcePush = true;
+}
+
+/**
+ * Engages or disengages the template mode - the first <code>szTemplate</code> pixels of <code>leds</code> are repeated over the entire strip.
+ * When disengaging, the template is replicated into <code>leds</code> so that the pixel buffer matches the strip content again (e.g. for transitions).
+ * @param szTemplate template size, in pixels; 0 turns off the template mode
+ */
+void StripOutput::setTemplate(const uint16_t szTemplate) {
+    const uint16_t sz = szTemplate >= numPixels ? 0 : szTemplate;
+    if (sz == tplSize)
+        return;
+    ledRing.linearize();
+    if ((tplSize > 0) && (sz == 0))
+        expandTemplate(leds);
+    tplSize = sz;
+    invalidate();
+}
+
+uint16_t StripOutput::templateSize() const {
+    return tplSize;
+}
+
+/**
+ * Repeats the template (start of the buffer) over an entire strip buffer, in whole template blocks - each copy doubles the block size
+ * @tparam T pixel type - <code>CRGB</code> or <code>CRGB16</code>
+ * @param dest buffer to fill, <code>numPixels</code> in size, with the template already in place at its start
+ */
+template<typename T> void StripOutput::expandTemplate(T *dest) const {
+    uint16_t pos = tplSize;
+    while (pos < numPixels) {
+        const uint16_t szBlock = min((uint16_t)(numPixels - pos), pos);
+        memcpy(dest + pos, dest, szBlock * sizeof(T));
+        pos += szBlock;
+    }
+}
+
+/**
+ * Engages or disengages the high resolution mode - the effect renders into the 16 bit pixel buffer (<code>highResBuffer</code>) rather
+ * than <code>leds</code>, the template mode does not apply. The content of the pixel buffer being left is carried over into the other, so that
+ * the strip content is preserved across the switch (e.g. for transitions, which work on <code>leds</code>). Engaging the mode cancels a
+ * crossfade in progress - the frame crossfaded out is held in the same buffer
+ * @param on true to engage the high resolution mode, false to disengage it
+ */
+void StripOutput::setHighRes(const bool on) {
+    if (on == highRes)
+        return;
+    ledRing.linearize();
+    if (on) {
+        fadeTime = 0;
+        for (uint16_t x = 0; x < numPixels; x++)
+            back16[x] = CRGB16(leds[x]);
+    } else {
+        for (uint16_t x = 0; x < numPixels; x++)
+            leds[x] = back16[x].toCRGB();
+    }
+    highRes = on;
+    invalidate();
+}
+
+bool StripOutput::isHighRes() const {
+    return highRes;
+}
+
+/**
+ * The 16 bit pixel buffer effects render into in high resolution mode
+ * @return the high resolution pixel buffer, <code>numPixels</code> in size
+ */
+CRGB16 *StripOutput::highResBuffer() {
+    return back16;
+}
+
+/**
+ * The buffer the FastLED controllers shift out to the strip - effects must not write into it
+ * @return the wire buffer, <code>numPixels</code> in size
+ */
+CRGB *StripOutput::wireBuffer() {
+    return wire;
+}
+
+/**
+ * FNV-1a hash over the pixel bytes, seeded with the brightness (and the pixel buffer's origin - a rotated buffer is a different frame)
+ * @param pixels pixel buffer
+ * @param szBytes size of the pixel buffer, in bytes
+ * @param seed brightness the pixels are shown with, in the low byte; origin of the pixel buffer above it
+ * @return 32 bit hash of the frame
+ */
+uint32_t StripOutput::frameHash(const void *pixels, const uint32_t szBytes, const uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    const auto *p = (const uint8_t *)pixels;
+    const uint8_t *end = p + szBytes;
+    while (p < end) {
+        hash ^= *p++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t StripOutput::frameCount() const {
+    return frames;
+}
+
+uint32_t StripOutput::skippedCount() const {
+    return skipped;
+}
+
+const TimingStats &StripOutput::showTiming() const {
+    return showStats;
+}
+
+/**
+ * Maps the outputs (data lines) over the active strip length, per the LED_OUTPUT_STARTS configuration. Must be called once the layout is known
+ * and before the outputs' controllers are registered.
+ * <p>If the configured ranges do not fit the strip - start pixels not ascending or past the end of the strip - the strip is split evenly
+ * across the outputs instead</p>
+ */
+void StripOutput::mapOutputs() {
+    bool valid = outputStarts[0] == 0;
+    for (uint8_t x = 1; x < LED_OUTPUTS; x++)
+        valid = valid && outputStarts[x] > outputStarts[x-1] && outputStarts[x] < numPixels;
+    if (!valid)
+        Log.errorln(F("Configured LED output ranges do not fit the %d pixels strip - splitting it evenly across %d outputs"), numPixels, LED_OUTPUTS);
+    for (uint8_t x = 0; x < LED_OUTPUTS; x++) {
+        const uint16_t start = valid ? outputStarts[x] : (uint32_t)numPixels * x / LED_OUTPUTS;
+        const uint16_t end = x < LED_OUTPUTS-1 ? (valid ? outputStarts[x+1] : (uint32_t)numPixels * (x+1) / LED_OUTPUTS) : numPixels;
+        outputs[x] = {outputPins[x], start, (uint16_t)(end - start)};
+        Log.infoln(F("LED output %d on pin %d: pixels [%d, %d], estimated wire time %d us"), x, outputs[x].pin, start, end-1, wireTime(outputs[x].size));
+    }
+}
+
+uint8_t StripOutput::outputCount() const {
+    return LED_OUTPUTS;
+}
+
+const LedOutput &StripOutput::output(const uint8_t index) const {
+    return outputs[index];
+}
+
+/**
+ * Estimated time to shift a frame out to the strip - the outputs shift concurrently, this is the wire time of the longest output
+ * @return frame wire time, in us
+ */
+uint32_t StripOutput::frameWireTime() const {
+    uint32_t maxTime = 0;
+    for (const auto &out : outputs)
+        maxTime = max(maxTime, wireTime(out.size));
+    return maxTime;
+}
+
+/**
+ * Estimated time to shift a number of pixels out on one data line, including the latch at the end of the frame
+ * @param pixels number of pixels on the line
+ * @return wire time, in us
+ */
+uint32_t StripOutput::wireTime(const uint16_t pixels) {
+    return (uint32_t)pixels * 24 * WIRE_BIT_TIME_NS / 1000 + WIRE_RESET_US;
+}
+
+/**
+ * Sets the white balance of the strip's LEDs - takes effect with the next frame
+ * @param corr color correction, e.g. <code>TypicalSMD5050</code>
+ */
+void StripOutput::setCorrection(const CRGB &corr) {
+    correction = corr;
+    lutDirty = true;
+    invalidate();
+}
+
+/**
+ * Sets the color temperature of the light - takes effect with the next frame
+ * @param temp color temperature, e.g. <code>Tungsten100W</code>
+ */
+void StripOutput::setTemperature(const CRGB &temp) {
+    temperature = temp;
+    lutDirty = true;
+    invalidate();
+}
+
+/**
+ * Sets the gamma of the output curve - takes effect with the next frame
+ * @param gamma gamma exponent; 1.0 for a linear output
+ */
+void StripOutput::setGamma(const float gamma) {
+    for (uint16_t x = 0; x < 256; x++)
+        gammaCurve[x] = (uint16_t)(powf(x / 255.0f, gamma) * 0xFF00 + 0.5f);
+    lutDirty = true;
+    invalidate();
+}
+
+/**
+ * Rebuilds the per channel lookup table - each channel's curve is the gamma curve scaled by that channel's correction and temperature, the
+ * same way FastLED combines them, and by the brightness through the gamma curve: scaling a channel value with the brightness before the curve
+ * is the same as scaling the curve with the brightness' own curve
+ * @param bright brightness to build the table for
+ */
+void StripOutput::buildLut(const uint8_t bright) {
+    const uint8_t corr[3] = {correction.r, correction.g, correction.b};
+    const uint8_t temp[3] = {temperature.r, temperature.g, temperature.b};
+    for (uint8_t ch = 0; ch < 3; ch++) {
+        const uint32_t scale = (uint32_t)corr[ch] * temp[ch] * gammaCurve[bright] / 65025;    //scale in [0, 0xFF00] - 0xFF00 leaves the curve unchanged
+        for (uint16_t x = 0; x < 256; x++)
+            lut[ch][x] = (uint32_t)gammaCurve[x] * scale / 0xFF00;
+    }
+    lutBright = bright;
+    lutDirty = false;
+}
+
+/**
+ * Copies pixels through the lookup table - linearizing a rotated source: the source pixels are read starting from <code>origin</code>,
+ * wrapping around the end of the source buffer
+ * @param dest destination buffer
+ * @param src source buffer
+ * @param szPixels number of pixels to copy
+ * @param origin index of the first pixel to copy in the source buffer
+ * @param sums per channel sums of the output values - accumulated into, for the power estimate
+ * @param st frame statistics - collected from the source pixels, per room segment
+ */
+void StripOutput::applyLut(CRGB16 *dest, const CRGB *src, const uint16_t szPixels, const uint16_t origin, uint32_t *sums, FrameStats &st) const {
+    const uint16_t *lutR = lut[0], *lutG = lut[1], *lutB = lut[2];
+    uint32_t sumR = 0, sumG = 0, sumB = 0, totalLuma = 0;
+    uint16_t lit = 0;
+    uint8_t maxLuma = 0;
+    uint16_t x = 0;
+    const CRGB *p = src + origin, *wrap = src + szPixels;
+    for (uint8_t s = 0; s < SEG_COUNT; s++) {
+        const uint16_t segEnd = min((uint16_t)(roomLayout[s].end + 1), szPixels);
+        uint16_t segLit = 0;
+        for (; x < segEnd; x++, dest++, p++) {
+            if (p == wrap)
+                p = src;
+            sumR += dest->r = lutR[p->r];
+            sumG += dest->g = lutG[p->g];
+            sumB += dest->b = lutB[p->b];
+            const uint8_t luma = p->getLuma();
+            totalLuma += luma;
+            maxLuma = max(maxLuma, luma);
+            segLit += luma > 0;
+        }
+        st.segmentLit[s] = segLit;
+        lit += segLit;
+    }
+    sums[0] += sumR;
+    sums[1] += sumG;
+    sums[2] += sumB;
+    st.litPixels = lit;
+    st.maxLuma = maxLuma;
+    st.totalLuma = totalLuma;
+}
+
+/**
+ * Copies high resolution pixels through the lookup table - the table is interpolated linearly between the entries around each value
+ * @param dest destination buffer
+ * @param src source buffer
+ * @param szPixels number of pixels to copy
+ * @param sums per channel sums of the output values - accumulated into, for the power estimate
+ * @param st frame statistics - collected from the source pixels (8 bit part), per room segment
+ */
+void StripOutput::applyLut(CRGB16 *dest, const CRGB16 *src, const uint16_t szPixels, uint32_t *sums, FrameStats &st) const {
+    uint32_t totalLuma = 0;
+    uint16_t lit = 0;
+    uint8_t maxLuma = 0;
+    uint16_t x = 0;
+    for (uint8_t s = 0; s < SEG_COUNT; s++) {
+        const uint16_t segEnd = min((uint16_t)(roomLayout[s].end + 1), szPixels);
+        uint16_t segLit = 0;
+        for (; x < segEnd; x++, dest++, src++) {
+            const uint16_t *sch = &src->r;
+            uint16_t *dch = &dest->r;
+            for (uint8_t ch = 0; ch < 3; ch++) {
+                const uint16_t *curve = lut[ch];
+                const uint8_t hi = sch[ch] >> 8, lo = sch[ch] & 0xFF;
+                const uint16_t a = curve[hi];
+                dch[ch] = hi < 255 ? a + (((int32_t)(curve[hi+1] - a) * lo) >> 8) : a;
+                sums[ch] += dch[ch];
+            }
+            const uint8_t luma = src->toCRGB().getLuma();
+            totalLuma += luma;
+            maxLuma = max(maxLuma, luma);
+            segLit += luma > 0;
+        }
+        st.segmentLit[s] = segLit;
+        lit += segLit;
+    }
+    st.litPixels = lit;
+    st.maxLuma = maxLuma;
+    st.totalLuma = totalLuma;
+}
+
+/**
+ * Converts a frame to 8 bit channels for the wire. When dithering, each channel's fraction is added to the residual carried over from the
+ * previous frame - the carry rounds the output up and the remainder becomes the new residual (first order error diffusion over time);
+ * otherwise the channels are rounded to nearest
+ * @param dest wire buffer
+ * @param src frame, 8.8 fixed point channels
+ * @param residual dithering residuals, 3 per pixel; <code>nullptr</code> to round rather than dither
+ * @param szPixels number of pixels to convert
+ */
+void StripOutput::ditherFrame(CRGB *dest, const CRGB16 *src, uint8_t *residual, const uint16_t szPixels) {
+    auto *d = (uint8_t *)dest;
+    const auto *s = (const uint16_t *)src;
+    const uint16_t *end = s + szPixels*3;
+    if (residual == nullptr) {
+        while (s < end)
+            *d++ = (*s++ + 0x80) >> 8;     //the output curve peaks at 0xFF00, no overflow
+        return;
+    }
+    while (s < end) {
+        const uint16_t v = *s++ + *residual;
+        *d++ = v >> 8;
+        *residual++ = v & 0xFF;
+    }
+}
+
+/**
+ * Estimates the current drawn by a frame and dims it to fit the power budget, if needed. The estimate is the sum of the channel values
+ * weighted by each channel's current at full intensity, plus the idle current of the pixels - the channel values are sums collected while
+ * the frame went through the output curve, no extra pass is needed unless the frame is dimmed
+ * @param frame frame to check, 8.8 fixed point channels
+ * @param sums per channel sums of the frame's values
+ */
+void StripOutput::limitPower(CRGB16 *frame, const uint32_t *sums) {
+    //sums are up to 1024 pixels x 0xFF00 - scale down by 256 first to keep the weighted sum within 32 bits
+    const uint32_t chDraw = ((sums[0] >> 8) * POWER_MA_RED + (sums[1] >> 8) * POWER_MA_GREEN + (sums[2] >> 8) * POWER_MA_BLUE) / 255;
+    const uint32_t idleDraw = (uint32_t)numPixels * POWER_MA_IDLE;
+    powerDraw = chDraw + idleDraw;
+    limited = powerDraw > budget && chDraw > 0;
+    if (!limited)
+        return;
+    //scale all channels by the fraction of the channel current that fits the budget
+    const uint32_t scale = budget > idleDraw ? (uint32_t)(budget - idleDraw) * 65536 / chDraw : 0;
+    auto *ch = (uint16_t *)frame;
+    const uint16_t *end = ch + numPixels*3;
+    for (; ch < end; ch++)
+        *ch = (*ch * scale) >> 16;
+    powerDraw = idleDraw + (uint32_t)((uint64_t)chDraw * scale >> 16);
+    limitedFrames++;
+}
+
+/**
+ * Sets the max current the strip may draw - frames estimated to draw more are dimmed to fit
+ * @param mA power budget, in mA
+ */
+void StripOutput::setPowerBudget(const uint16_t mA) {
+    budget = mA;
+    invalidate();
+}
+
+uint16_t StripOutput::powerBudget() const {
+    return budget;
+}
+
+/**
+ * Estimated current drawn by the strip with the last frame pushed - after dimming it to the power budget, if it was the case
+ * @return current estimate, in mA
+ */
+uint32_t StripOutput::powerEstimate() const {
+    return powerDraw;
+}
+
+bool StripOutput::isPowerLimited() const {
+    return limited;
+}
+
+uint32_t StripOutput::powerLimitedCount() const {
+    return limitedFrames;
+}
+
+/**
+ * Statistics of the last frame pushed to the strip - frames skipped as identical with the last one pushed have the same statistics
+ * @return frame statistics, collected as the frame went through the output curve
+ */
+const FrameStats &StripOutput::frameStats() const {
+    return stats;
+}
+
+RingSet::RingSet(CRGB *pixels, const uint16_t szPixels) : pixels(pixels), sz(szPixels), head(0) {}
+
+uint16_t RingSet::size() const {
+    return sz;
+}
+
+/**
+ * Physical index of the logical pixel 0
+ * @return the origin of the view
+ */
+uint16_t RingSet::origin() const {
+    return head;
+}
+
+/**
+ * The physical buffer - in logical order only after <code>linearize</code>
+ * @return the pixel buffer the view is over
+ */
+CRGB *RingSet::data() {
+    return pixels;
+}
+
+/**
+ * Fills a logical range of the view with a color - at most two contiguous runs in the physical buffer
+ * @param from first logical pixel to fill
+ * @param count number of pixels to fill - capped at the view's size
+ * @param color the color to fill with
+ */
+void RingSet::fill(const uint16_t from, const uint16_t count, const CRGB &color) {
+    if (sz == 0)
+        return;
+    const uint16_t n = capu(count, sz);
+    uint16_t x = head + from % sz;
+    if (x >= sz)
+        x -= sz;
+    const uint16_t run = min(n, (uint16_t)(sz - x));
+    fill_solid(pixels + x, run, color);
+    if (n > run)
+        fill_solid(pixels, n - run, color);
+}
+
+/**
+ * Rotates the view to the right - the pixels falling off the right end enter through the left. Moves the origin only
+ * @param pos how many positions to rotate
+ */
+void RingSet::rotateRight(const uint16_t pos) {
+    if (sz == 0)
+        return;
+    const uint16_t p = pos % sz;
+    head = head >= p ? head - p : head + sz - p;
+}
+
+/**
+ * Rotates the view to the left - the pixels falling off the left end enter through the right. Moves the origin only
+ * @param pos how many positions to rotate
+ */
+void RingSet::rotateLeft(const uint16_t pos) {
+    if (sz == 0)
+        return;
+    const uint32_t h = head + pos % sz;
+    head = h < sz ? h : h - sz;
+}
+
+/**
+ * Shifts the view to the right, same outcome as <code>shiftRight(CRGBSet&, ...)</code> over the entire set - the origin moves left and only
+ * the pixels entering from the left are written
+ * @param feedLeft the color to introduce from the left
+ * @param pos how many positions to shift
+ */
+void RingSet::shiftRight(const CRGB &feedLeft, const uint16_t pos) {
+    if (pos < sz)
+        rotateRight(pos);
+    fill(0, pos, feedLeft);
+}
+
+/**
+ * Shifts the view to the left, same outcome as <code>shiftLeft(CRGBSet&, ...)</code> over the entire set - the origin moves right and only
+ * the pixels entering from the right are written
+ * @param feedRight the color to introduce from the right
+ * @param pos how many positions to shift
+ */
+void RingSet::shiftLeft(const CRGB &feedRight, const uint16_t pos) {
+    if (pos < sz) {
+        rotateLeft(pos);
+        fill(sz - pos, pos, feedRight);
+    } else
+        fill(0, sz, feedRight);
+}
+
+/**
+ * Moves the pixels in place such that the logical order matches the physical order - origin back at 0
+ */
+void RingSet::linearize() {
+    if (head == 0)
+        return;
+    std::rotate(pixels, pixels + head, pixels + sz);
+    head = 0;
+}
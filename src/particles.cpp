@@ -0,0 +1,24 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#include "particles.h"
+
+/**
+ * Advances the particles one frame - moves them by their velocity, keeps them within <code>[0, limit]</code> and accelerates them by gravity.
+ * @param particles the particles to update
+ * @param count number of particles
+ * @param gravity acceleration applied to each particle's velocity, in pixels/frame^2 - negative pulls towards the bottom
+ * @param limit highest position allowed
+ * @return number of particles above the bottom pixel after the update
+ */
+uint16_t particlesStep(Particle *particles, const uint16_t count, const fix16 gravity, const fix16 limit) {
+    uint16_t active = 0;
+    for (Particle *p = particles, *end = particles + count; p < end; p++) {
+        const fix16 pos = p->pos + p->velocity;
+        p->pos = pos < 0 ? 0 : (pos > limit ? limit : pos);
+        p->velocity += gravity;
+        if (p->pos >= FIX16_ONE)
+            active++;
+    }
+    return active;
+}
@@ -0,0 +1,124 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#include "pixelmap.h"
+#include "util.h"
+#include <ArduinoJson.h>
+
+static const char *const segmentNames[SEG_COUNT] = {"up", "right", "front", "left", "back"};
+
+uint16_t numPixels = NUM_PIXELS;
+SegmentDef roomLayout[SEG_COUNT] = {defaultLayout[SegUp], defaultLayout[SegRight], defaultLayout[SegFront], defaultLayout[SegLeft], defaultLayout[SegBack]};
+PixelMap pixelMap;
+
+/**
+ * (Re)computes the map tables for the layout given
+ * @param segs segments of the layout - must cover the strip, in order, without gaps
+ * @param count number of segments
+ */
+void PixelMap::build(const SegmentDef *segs, const uint8_t count) {
+    segments = segs;
+    perimeterSize = 0;
+    for (uint8_t s = 0; s < count; s++)
+        if (segs[s].perimeter)
+            perimeterSize += segs[s].size();
+    uint16_t base = 0;      //perimeter offset of the current segment
+    for (uint8_t s = 0; s < count; s++) {
+        const SegmentDef &sd = segs[s];
+        const uint16_t sz = sd.size();
+        for (uint16_t i = 0; i < sz; i++) {
+            const uint16_t px = sd.start + i;
+            const uint16_t t = sd.reversed ? sz - 1 - i : i;   //position of the pixel in the direction of travel
+            segment[px] = s;
+            local[px] = sz > 1 ? (uint32_t)t * 0xFFFF / (sz - 1) : 0;
+            if (sd.perimeter) {
+                perimeter[base + t] = px;
+                coord[px] = (((uint32_t)(base + t) << 16) + perimeterSize - 1) / perimeterSize;     //rounded up, so that perimeterPixel(coord[px]) == px
+            } else
+                coord[px] = local[px];
+        }
+        if (sd.perimeter)
+            base += sz;
+    }
+}
+
+/**
+ * Validates a layout - the segments must be in <code>SegmentId</code> order, contiguous, cover the whole strip and be at least
+ * <code>MIN_SEGMENT_SIZE</code> pixels each
+ * @param segs segments to validate
+ * @param pixels number of pixels on the strip
+ * @return true if the layout is usable; false otherwise
+ */
+static bool isValidLayout(const SegmentDef *segs, const uint16_t pixels) {
+    if (pixels < MIN_NUM_PIXELS || pixels > MAX_NUM_PIXELS) {
+        Log.errorln(F("Layout pixel count %d is outside of the supported range [%d, %d]"), pixels, MIN_NUM_PIXELS, MAX_NUM_PIXELS);
+        return false;
+    }
+    uint16_t next = 0;      //expected start of the next segment
+    for (uint8_t s = 0; s < SEG_COUNT; s++) {
+        if (segs[s].start != next || segs[s].end < segs[s].start || segs[s].size() < MIN_SEGMENT_SIZE) {
+            Log.errorln(F("Layout segment %s [%d, %d] is invalid - expected to start at %d, at least %d pixels"), segmentNames[s],
+                        segs[s].start, segs[s].end, next, MIN_SEGMENT_SIZE);
+            return false;
+        }
+        next = segs[s].end + 1;
+    }
+    if (next != pixels) {
+        Log.errorln(F("Layout segments cover %d pixels, expected %d"), next, pixels);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Makes a layout the active one - room segments, pixel count and pixel map. The global color sets spanning the strip must be re-seated
+ * afterwards, see <code>applyLayout</code>
+ * @param segs segments of the layout, in <code>SegmentId</code> order
+ * @param pixels number of pixels on the strip
+ * @return true if the layout is valid and now active; false otherwise (active layout unchanged)
+ */
+bool setLayout(const SegmentDef *segs, const uint16_t pixels) {
+    if (!isValidLayout(segs, pixels))
+        return false;
+    memcpy(roomLayout, segs, sizeof(roomLayout));
+    numPixels = pixels;
+    pixelMap.build(roomLayout, SEG_COUNT);
+    return true;
+}
+
+/**
+ * Reads the room layout from the <code>layout.json</code> file, if present - and builds the pixel map for the active layout. Expected format:
+ * <pre>
+ * {"pixels": 170, "segments": {"up": [0, 23], "right": [24, 61], "front": [62, 93], "left": [94, 133], "back": [134, 169, true]}}
+ * </pre>
+ * where each segment lists its first and last pixel indexes (inclusive) and optionally whether it is reversed.
+ * <p>The board's default layout (config.h) stays in effect when the file is missing or invalid. Must run before the LED strip and the
+ * effects are setup - both size themselves off the active pixel count</p>
+ * @return true if the layout was read from the file; false if the default layout is in effect
+ */
+bool readLayout() {
+    bool loaded = false;
+    String json;
+    if (readTextFile(layoutFileName, &json) > 0) {
+        StaticJsonDocument<LAYOUT_JSON_DOC_SIZE> doc;   //this takes memory from the thread stack, ensure fx thread's memory size is adjusted if this value is
+        DeserializationError error = deserializeJson(doc, json);
+        if (error)
+            Log.errorln(F("Layout file %s could not be parsed: %s"), layoutFileName, error.c_str());
+        else {
+            const uint16_t pixels = doc["pixels"].as<uint16_t>();
+            SegmentDef segs[SEG_COUNT];
+            for (uint8_t s = 0; s < SEG_COUNT; s++) {
+                JsonArrayConst jsSeg = doc["segments"][segmentNames[s]].as<JsonArrayConst>();
+                segs[s] = {jsSeg[0].as<uint16_t>(), jsSeg[1].as<uint16_t>(), jsSeg[2].as<bool>(), defaultLayout[s].perimeter};
+            }
+            loaded = setLayout(segs, pixels);
+        }
+    }
+    if (!loaded)
+        pixelMap.build(roomLayout, SEG_COUNT);
+    Log.infoln(F("Room layout %s: %d pixels, segments up [%d, %d], right [%d, %d], front [%d, %d], left [%d, %d], back [%d, %d]"),
+               loaded ? layoutFileName : "default", numPixels, roomLayout[SegUp].start, roomLayout[SegUp].end, roomLayout[SegRight].start,
+               roomLayout[SegRight].end, roomLayout[SegFront].start, roomLayout[SegFront].end, roomLayout[SegLeft].start,
+               roomLayout[SegLeft].end, roomLayout[SegBack].start, roomLayout[SegBack].end);
+    return loaded;
+}
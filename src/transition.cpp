@@ -4,24 +4,60 @@
 #include "transition.h"
 #include "efx_setup.h"
 
+#define SPLIT_FADE_RATE     120     //fade amount of the split segments, per frame
+#define BAR_FADE_RATE       120     //fade amount of the random bars' pixels, per frame
+#define STRIP_FADE_RATE     32      //fade amount of the whole strip fade, per frame
+
+/**
+ * Number of frames a pixel at full intensity takes to fade below <code>TRANSITION_OFF_LEVEL</code>
+ * @param rate fade amount applied each frame - see CRGB::fadeToBlackBy; must be positive
+ * @return number of frames
+ */
+static uint8_t fadeFrames(const uint8_t rate) {
+    uint8_t frames = 0;
+    for (uint8_t v = 255; v >= TRANSITION_OFF_LEVEL; v = scale8(v, 255-rate))
+        frames++;
+    return frames;
+}
+
+/**
+ * Frame of a wipe after which a range of the strip is off - the wipe shifts the range one pixel per frame, feeding black
+ * @param low first pixel of the range
+ * @param high end of the range - first pixel past it
+ * @param rightDir whether the range is shifted right or left
+ * @return the frame the last lit pixel is shifted out of the range at; 0 when no pixel is lit
+ */
+static uint16_t wipeEnd(const uint16_t low, const uint16_t high, const bool rightDir) {
+    if (rightDir) {
+        for (uint16_t x = low; x < high; x++)
+            if (leds[x])
+                return high - x - 1;
+    } else {
+        for (uint16_t x = high; x > low; x--)
+            if (leds[x-1])
+                return x - 1 - low;
+    }
+    return 0;
+}
+
 // EffectTransition - we have 5 distinct off effects
 void EffectTransition::setup() {
     prefFx = 0;     //no preference - i.e. automatic from sel
     sel = random8() % 10;
-    if (randomBarSegs.empty())
+    if (barCount == 0)
         resetRandomBars();
 }
 
 void EffectTransition::resetRandomBars() {
-    randomBarSegs.clear();
+    barCount = 0;
     uint16_t sum = 0;
-    while (sum < NUM_PIXELS) {
+    while (sum < numPixels) {
         uint8_t szSeg = random8(3, 10);
-        randomBarSegs.push_front(szSeg);
+        barSizes[barCount++] = szSeg;
         sum += szSeg;
     }
-    if (sum > NUM_PIXELS)
-        randomBarSegs.front() -= (sum-NUM_PIXELS);
+    if (sum > numPixels)
+        barSizes[barCount-1] -= (sum-numPixels);
 }
 
 bool EffectTransition::transition() {
@@ -44,48 +80,85 @@ void EffectTransition::prepare(uint selector) {
     if (prefFx) {
         prefFx = (prefFx % effectsCount) + 1;
     }
-
-    //offSpots prepare
-    offSpotShuffleOffset = 0;
-    offPosIndex = 0;
-    offSpotSegSize = turnOffSeq[offPosIndex];
-    fade = random8(42, 110);
+    //the plan is compiled on the transition's first frame - from the strip content the transition starts with
+    planKey = 0;
 }
 
 uint EffectTransition::selector() const {
     return sel;
 }
 
+/**
+ * Whether the plan needs compiling for a transition - i.e. there is no plan, or the plan was compiled for another transition. Starts the
+ * transition's frame count when it does
+ * @param effect transition - index of the 'offXYZ' method, same as in <code>transition()</code>
+ * @param variant transition variant (e.g. direction)
+ * @return true if the plan needs compiling
+ */
+bool EffectTransition::needsPlan(const uint8_t effect, const bool variant) {
+    const uint8_t key = 1 + effect*2 + variant;
+    if (key == planKey)
+        return false;
+    planKey = key;
+    step = 0;
+    planEnd = 0;
+    return true;
+}
+
+/**
+ * Plans the fade out of one pixel - a pixel that is already off takes no frames
+ * @param index pixel index
+ * @param start transition frame the fade starts at
+ * @param rate fade amount, per frame
+ * @param frames number of frames to fade for
+ */
+void EffectTransition::planPixel(const uint16_t index, const uint16_t start, const uint8_t rate, const uint8_t frames) {
+    const uint8_t fr = leds[index] ? frames : 0;
+    plan[index] = {start, rate, fr};
+    planEnd = max(planEnd, (uint16_t)(start + fr));
+}
+
+/**
+ * Runs one frame of the fade plan - a single pass over the strip - and shows it
+ * @return true if the plan has completed - all pixels are off
+ */
+bool EffectTransition::runPlan() {
+    for (uint16_t x = 0; x < numPixels; x++) {
+        const FadeStep &fs = plan[x];
+        if (step < fs.start)
+            continue;
+        if (step - fs.start < fs.frames)
+            leds[x].fadeToBlackBy(fs.rate);
+        else
+            leds[x] = BKG;
+    }
+    stripOutput.show(stripBrightness);
+    return endFrame();
+}
+
+/**
+ * Advances the transition's frame count. When the plan has completed, it is dropped - running the transition again plans it anew
+ * @return true if the plan has completed with this frame
+ */
+bool EffectTransition::endFrame() {
+    const bool done = step >= planEnd;
+    step++;
+    if (done)
+        planKey = 0;
+    return done;
+}
+
 /**
  * Turns off entire strip by random spots, in increasing size until all LEDs are off
  * <p>This function needs called repeatedly until it returns true</p>
  * @return true if all LEDs are off, false otherwise
  */
 bool EffectTransition::offSpots() {
+    if (needsPlan(0, false))
+        planSpots();
     bool allOff = false;
-
     EVERY_N_MILLIS(30) {
-        uint8_t ledsOn = 0;
-        for (uint16_t x = 0; x < offSpotSegSize; x++) {
-            uint16_t xled = stripShuffleIndex[(offSpotShuffleOffset + x) % NUM_PIXELS];
-            FastLED.leds()[xled].fadeToBlackBy(fade);
-            if (FastLED.leds()[xled].getLuma() < 4)
-                FastLED.leds()[xled] = BKG;
-            else
-                ledsOn++;
-        }
-
-        FastLED.show(stripBrightness);
-        if (ledsOn == 0) {
-            offSpotShuffleOffset = inc(offSpotShuffleOffset, offSpotSegSize, NUM_PIXELS);  //need to increment with szOffSpot before advancing it
-            offPosIndex = inc(offPosIndex, 1, arrSize(turnOffSeq));
-            offSpotSegSize = turnOffSeq[offPosIndex];
-            fade = random8(42, 110);
-        }
-    }
-
-    EVERY_N_MILLIS(500) {
-        allOff = !isAnyLedOn(FastLED.leds(), FastLED.size(), BKG);
+        allOff = runPlan();
     }
 
     return allOff;
@@ -97,17 +170,19 @@ bool EffectTransition::offSpots() {
  * @return true if all leds are off, false otherwise
  */
 bool EffectTransition::offWipe(bool rightDir) {
+    if (needsPlan(1, rightDir))
+        planWipe(rightDir);
     bool allOff = false;
     EVERY_N_MILLIS(60) {
-        CRGBSet strip(leds, NUM_PIXELS);
+        //shifting the whole strip moves its origin - the output stage linearizes the frame
         if (rightDir)
-            shiftRight(strip, BKG);
+            shiftRight(ledRing, BKG);
         else
-            shiftLeft(strip, BKG);
-        FastLED.show(stripBrightness);
-    }
-    EVERY_N_MILLIS(720) {
-        allOff = !isAnyLedOn(leds, NUM_PIXELS, BKG);
+            shiftLeft(ledRing, BKG);
+        stripOutput.show(stripBrightness);
+        allOff = endFrame();
+        if (allOff)
+            ledRing.linearize();    //the strip is black - restores the pixel order for effects resuming after the wipe
     }
 
     return allOff;
@@ -119,11 +194,13 @@ bool EffectTransition::offWipe(bool rightDir) {
  * @return true if all leds are off, false otherwise
  */
 bool EffectTransition::offHalfWipe(bool inward) {
+    if (needsPlan(5, inward))
+        planHalfWipe(inward);
     bool allOff = false;
     EVERY_N_MILLIS(60) {
-        const uint16_t halfSize = NUM_PIXELS/2;
+        const uint16_t halfSize = numPixels/2;
         CRGBSet stripH1(leds, halfSize);
-        CRGBSet stripH2(leds, halfSize, NUM_PIXELS-1);
+        CRGBSet stripH2(leds, halfSize, numPixels-1);
         if (inward) {
             //inward
             shiftRight(stripH1, BKG);
@@ -133,10 +210,8 @@ bool EffectTransition::offHalfWipe(bool inward) {
             shiftLeft(stripH1, BKG);
             shiftRight(stripH2, BKG);
         }
-        FastLED.show(stripBrightness);
-    }
-    EVERY_N_MILLIS(720) {
-        allOff = !isAnyLedOn(leds, NUM_PIXELS, BKG);
+        stripOutput.show(stripBrightness);
+        allOff = endFrame();
     }
 
     return allOff;
@@ -147,14 +222,11 @@ bool EffectTransition::offHalfWipe(bool inward) {
  * @return true if all leds are off, false otherwise
  */
 bool EffectTransition::offFade() {
+    if (needsPlan(2, false))
+        planFade();
     bool allOff = false;
     EVERY_N_MILLIS(50) {
-        CRGBSet strip(leds, NUM_PIXELS);
-        strip.fadeToBlackBy(32);
-        FastLED.show(stripBrightness);
-    }
-    EVERY_N_MILLIS(500) {
-        allOff = !isAnyLedOn(leds, NUM_PIXELS, BKG);
+        allOff = runPlan();
     }
     return allOff;
 }
@@ -165,24 +237,12 @@ bool EffectTransition::offFade() {
  * @return true if all leds are off, false otherwise
  */
 bool EffectTransition::offSplit(bool outward) {
+    if (needsPlan(3, outward))
+        planSplit(outward);
     bool allOff = false;
     EVERY_N_MILLIS(50) {
-        const uint16_t halfSize = NUM_PIXELS/2;
-        const uint16_t maxIndex = NUM_PIXELS-1;
-        const uint16_t offSegSize = 1+offPosIndex/8;
-        CRGBSet s1(leds, outward?offPosIndex:qsuba(halfSize-1, offPosIndex), outward?(offPosIndex+offSegSize):qsuba(halfSize-1, offPosIndex+offSegSize));
-        CRGBSet s2(leds, outward?(maxIndex-offPosIndex):capu(halfSize+offPosIndex, maxIndex), outward?(maxIndex-offPosIndex-offSegSize):capu(halfSize+offPosIndex+offSegSize, maxIndex));
-        s1.nblend(BKG, 120);
-        s2.nblend(BKG, 120);
-        if (!s1 && !s2)
-            offPosIndex+=(1+offSegSize);
-
-        FastLED.show(stripBrightness);
-        allOff = offPosIndex >= halfSize;
+        allOff = runPlan();
     }
-//    EVERY_N_MILLIS(500) {
-//        allOff = !isAnyLedOn(leds, NUM_PIXELS, BKG);
-//    }
     return allOff;
 }
 
@@ -192,18 +252,116 @@ bool EffectTransition::offSplit(bool outward) {
  * @return true if all leds are off, false otherwise
  */
 bool EffectTransition::offRandomBars(bool rightDir) {
+    if (needsPlan(4, rightDir))
+        planRandomBars(rightDir);
     bool allOff = false;
     EVERY_N_MILLIS(50) {
-        uint16_t ovrSz = 0;
-        bool segOff = true;
-        for (auto &sz : randomBarSegs) {
-            CRGBSet seg(leds, rightDir?ovrSz:(ovrSz+sz-1), rightDir?(ovrSz+sz-1):ovrSz);
-            if (!spreadColor(seg, BKG, 120))
-                segOff = false;
-            ovrSz+=sz;
-        }
-        FastLED.show(stripBrightness);
-        allOff = segOff;
+        allOff = runPlan();
     }
     return allOff;
 }
+
+/**
+ * Plans the spots transition - the pixels fade out in groups of increasing size (see <code>turnOffSeq</code>), in the strip's shuffled order.
+ * Each group fades at its own random rate, once the previous group is off; a group with no lit pixels takes no time
+ */
+void EffectTransition::planSpots() {
+    uint16_t start = 0;
+    uint8_t seqIndex = 0;
+    for (uint16_t x = 0; x < numPixels; ) {
+        const uint16_t szGroup = min(turnOffSeq[seqIndex], (uint16_t)(numPixels - x));
+        const uint8_t rate = random8(42, 110);
+        const uint8_t frames = fadeFrames(rate);
+        const uint16_t groupEnd = planEnd;
+        for (uint16_t y = x; y < x + szGroup; y++)
+            planPixel(stripShuffleIndex[y], start, rate, frames);
+        if (planEnd > groupEnd)
+            start += frames;
+        x += szGroup;
+        seqIndex = inc(seqIndex, 1, arrSize(turnOffSeq));
+    }
+}
+
+/**
+ * Plans the wipe transition - the number of shifts that take the lit pixel farthest from the wipe's end off the strip
+ * @param rightDir whether the strip is shifted right or left
+ */
+void EffectTransition::planWipe(const bool rightDir) {
+    ledRing.linearize();
+    planEnd = wipeEnd(0, numPixels, rightDir);
+}
+
+/**
+ * Plans the half wipe transition - the number of shifts that clear both halves, each half shifted in its own direction
+ * @param inward whether the halves are shifted towards the center or towards the ends
+ */
+void EffectTransition::planHalfWipe(const bool inward) {
+    const uint16_t halfSize = numPixels/2;
+    planEnd = max(wipeEnd(0, halfSize, inward), wipeEnd(halfSize, numPixels, !inward));
+}
+
+/**
+ * Plans the fade transition - all pixels fade at the same rate, from the first frame
+ */
+void EffectTransition::planFade() {
+    const uint8_t frames = fadeFrames(STRIP_FADE_RATE);
+    for (uint16_t x = 0; x < numPixels; x++)
+        planPixel(x, 0, STRIP_FADE_RATE, frames);
+}
+
+/**
+ * Plans the split transition - the two halves fade in segments growing in size with the distance travelled (1 + distance/8), mirrored
+ * around the center; a segment starts fading once the previous is off
+ * @param outward whether the segments start from the strip's ends or from its center (see <code>offSplit</code>)
+ */
+void EffectTransition::planSplit(const bool outward) {
+    const uint16_t halfSize = numPixels/2;
+    const uint16_t maxIndex = numPixels-1;
+    const uint16_t maxDist = outward ? maxIndex/2 : maxIndex-halfSize;
+    const uint8_t frames = fadeFrames(SPLIT_FADE_RATE);
+    uint16_t start = 0;
+    for (uint16_t pos = 0; pos <= maxDist; ) {
+        const uint16_t offSegSize = 1+pos/8;
+        const uint16_t segEnd = min((uint16_t)(pos + offSegSize), maxDist);
+        const uint16_t prevEnd = planEnd;
+        for (uint16_t d = pos; d <= segEnd; d++) {
+            if (outward) {
+                planPixel(d, start, SPLIT_FADE_RATE, frames);
+                planPixel(maxIndex-d, start, SPLIT_FADE_RATE, frames);
+            } else {
+                if (d < halfSize)
+                    planPixel(halfSize-1-d, start, SPLIT_FADE_RATE, frames);
+                planPixel(halfSize+d, start, SPLIT_FADE_RATE, frames);
+            }
+        }
+        if (planEnd > prevEnd)
+            start += frames;
+        pos += 1+offSegSize;
+    }
+}
+
+/**
+ * Plans the random bars transition - within each bar the pixels fade one at a time in the wipe direction, each once the previous is off;
+ * the bars fade concurrently. Pixels already off are skipped. The bars are drawn anew when they no longer span the strip - after a layout change
+ * @param rightDir whether the bars are wiped from left to right or right to left
+ */
+void EffectTransition::planRandomBars(const bool rightDir) {
+    uint16_t span = 0;
+    for (uint16_t b = 0; b < barCount; b++)
+        span += barSizes[b];
+    if (span != numPixels)
+        resetRandomBars();
+    const uint8_t frames = fadeFrames(BAR_FADE_RATE);
+    uint16_t ovrSz = 0;
+    for (uint16_t b = 0; b < barCount; b++) {
+        const uint8_t sz = barSizes[b];
+        uint16_t start = 0;
+        for (uint8_t y = 0; y < sz; y++) {
+            const uint16_t x = rightDir ? ovrSz+y : ovrSz+sz-1-y;
+            planPixel(x, start, BAR_FADE_RATE, frames);
+            if (leds[x])
+                start += frames;
+        }
+        ovrSz += sz;
+    }
+}
@@ -4,6 +4,8 @@
 
 #include "util.h"
 #include "utility/ECCX08DefaultTLSConfig.h"
+#include <algorithm>
+#include <pico/multicore.h>
 // increase the amount of space for file system to 128kB (default 64kB)
 #define RP2040_FS_SIZE_KB   (128)
 #include <LittleFSWrapper.h>
@@ -11,6 +13,7 @@
 #define FILE_BUF_SIZE   256
 const uint maxAdc = 1 << ADC_RESOLUTION;
 const char stateFileName[] = LITTLEFS_FILE_PREFIX "/state.json";
+const char layoutFileName[] = LITTLEFS_FILE_PREFIX "/layout.json";
 
 static uint8_t sysStatus = 0x00;    //system status bit array
 FixedQueue<TimeSync, 8> timeSyncs;
@@ -170,27 +173,41 @@ size_t readTextFile(const char *fname, String *s) {
 
 /**
  * Writes (overrides if already exists) a file using the string content
+ * <p>The second core is paused (flash lockout) for the duration of the write - it must have been started, see <code>StripOutput::begin</code></p>
  * @param fname file name to write
  * @param s contents to write
  * @return number of bytes written
  */
 size_t writeTextFile(const char *fname, String *s) {
     size_t fsize = 0;
+    multicore_lockout_start_blocking();
     FILE *f = fopen(fname, "w");
     if (f) {
         fsize = fwrite(s->c_str(), sizeof(s->charAt(0)), s->length(), f);
         fclose(f);
+    }
+    multicore_lockout_end_blocking();
+    if (f)
         Log.infoln(F("File %s has been saved, size %d bytes"), fname, s->length());
-    } else
+    else
         Log.errorln(F("Failed to create file %s for writing"), fname);
     return fsize;
 }
 
+/**
+ * Removes a file
+ * <p>The second core is paused (flash lockout) for the duration of the removal - it must have been started, see <code>StripOutput::begin</code></p>
+ * @param fname file name to remove
+ * @return true if the file does not exist anymore
+ */
 bool removeFile(const char *fname) {
     FILE *f = fopen(fname, "r");
     if (f) {
         fclose(f);
-        return lfs.remove(fname) == 0;
+        multicore_lockout_start_blocking();
+        const bool removed = lfs.remove(fname) == 0;
+        multicore_lockout_end_blocking();
+        return removed;
     }
     //file does not exist - return true to the caller, the intent is already fulfilled
     return true;
@@ -343,4 +360,95 @@ bool secElement_setup() {
     return true;
 }
 
+// TimingStats
+/**
+ * Records a time measurement
+ * @param us measurement in microseconds
+ */
+void TimingStats::record(uint32_t us) {
+    seq = seq + 1;
+    __DMB();
+    samples[pos] = us > UINT16_MAX ? UINT16_MAX : us;
+    pos = (pos + 1) % TIMING_SAMPLES;
+    count++;
+    totalTime += us;
+    if (us < minTime)
+        minTime = us;
+    if (us > maxTime)
+        maxTime = us;
+    __DMB();
+    seq = seq + 1;
+}
+
+void TimingStats::reset() {
+    seq = seq + 1;
+    __DMB();
+    memset(samples, 0, sizeof(samples));
+    pos = 0;
+    count = 0;
+    minTime = UINT32_MAX;
+    maxTime = 0;
+    totalTime = 0;
+    __DMB();
+    seq = seq + 1;
+}
+
+/**
+ * Consistent copy of the statistics, safe to take from a thread (or core) other than the one recording the measurements. The copy is
+ * retried until no measurement was recorded while copying
+ * @return copy of the statistics
+ */
+TimingStats TimingStats::snapshot() const {
+    TimingStats copy;
+    while (true) {
+        const uint32_t start = seq;
+        if ((start & 0x01) == 0) {
+            __DMB();
+            memcpy(copy.samples, samples, sizeof(samples));
+            copy.pos = pos;
+            copy.count = count;
+            copy.minTime = minTime;
+            copy.maxTime = maxTime;
+            copy.totalTime = totalTime;
+            __DMB();
+            if (seq == start)
+                return copy;
+        }
+        yield();    //a measurement is being recorded - let the recording thread complete it
+    }
+}
+
+uint32_t TimingStats::getCount() const {
+    return count;
+}
 
+uint32_t TimingStats::getMin() const {
+    return count ? minTime : 0;
+}
+
+uint32_t TimingStats::getMax() const {
+    return maxTime;
+}
+
+uint32_t TimingStats::getAverage() const {
+    return count ? totalTime / count : 0;
+}
+
+/**
+ * Percentile over the most recent measurements - the samples are copied and partially sorted, hence not a cheap call. Intended for
+ * reporting purposes
+ * @param pct percentile to compute, 1-100
+ * @return the measurement (in us, saturated at UINT16_MAX) below which the given percentage of recent measurements fall
+ */
+uint16_t TimingStats::getPercentile(uint8_t pct) const {
+    const uint16_t szSamples = count < TIMING_SAMPLES ? count : TIMING_SAMPLES;
+    if (szSamples == 0 || pct == 0)
+        return 0;
+    uint16_t buf[TIMING_SAMPLES];
+    memcpy(buf, samples, szSamples*sizeof(samples[0]));
+    //nearest-rank method - rank is ceil(pct/100 * szSamples)
+    const uint16_t rank = (szSamples*(pct > 100 ? 100 : pct) + 99)/100;
+    const uint16_t ix = rank - 1;
+    std::nth_element(buf, buf+ix, buf+szSamples);
+    return buf[ix];
+}
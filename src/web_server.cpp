@@ -136,6 +136,20 @@ size_t writeLargeP(WiFiClient *client, const char *src, size_t srcSize) {
     return sz;
 }
 
+/**
+ * Utility to describe timing statistics in JSON - all durations are in microseconds
+ * @param json the JSON object to populate
+ * @param liveStats the timing statistics - recorded by another thread, a snapshot is described
+ */
+void timingStatsJson(JsonObject json, const TimingStats &liveStats) {
+    const TimingStats stats = liveStats.snapshot();
+    json["count"] = stats.getCount();
+    json["min"] = stats.getMin();
+    json["avg"] = stats.getAverage();
+    json["max"] = stats.getMax();
+    json["p99"] = stats.getPercentile(99);
+}
+
 /**
  * Handles <code>GET /wifi.json</code> - responds with JSON document containing WiFi connectivity details
  * <p>Must comply with the <code>reqHandler</code> function pointer signature</p>
@@ -360,7 +374,7 @@ size_t web::handleGetStatus(WiFiClient *client, String *uri, String *hd, String
     sz += client->println();    //done with headers
 
     // response body
-    StaticJsonDocument<1152> doc;
+    DynamicJsonDocument doc(STATUS_JSON_DOC_SIZE);   //too large for the web server thread's stack
     // WiFi
     JsonObject wifi = doc.createNestedObject("wifi");
     wifi["IP"] = WiFi.localIP();         //IP Address
@@ -373,6 +387,7 @@ size_t web::handleGetStatus(WiFiClient *client, String *uri, String *hd, String
     JsonObject fx = doc.createNestedObject("fx");
     fx["count"] = fxRegistry.size();
     fx["auto"] = fxRegistry.isAutoRoll();
+    fx["crossfade"] = fxRegistry.crossfadeTime();           //duration of the crossfade between effects, ms; 0 - effects wind down instead
     fx["holiday"] = holidayToString(paletteFactory.getHoliday());   //could be forced to a fixed value
     const LedEffect *curFx = fxRegistry.getCurrentEffect();
     fx["index"] = curFx->getRegistryIndex();
@@ -386,6 +401,35 @@ size_t web::handleGetStatus(WiFiClient *client, String *uri, String *hd, String
     JsonArray audioHist = fx.createNestedArray("audioHist");
     for (uint16_t x : maxAudio)
         audioHist.add(x);
+    // Fx timing - only the effects that have rendered frames are listed
+    JsonObject fxTiming = doc.createNestedObject("fxTiming");
+    fxTiming["frames"] = stripOutput.frameCount();
+    fxTiming["framesSkipped"] = stripOutput.skippedCount();     //frames identical with the strip content, not pushed
+    fxTiming["framesMissed"] = fxRegistry.missedFrameCount();   //frames that overran into the next frame's time
+    timingStatsJson(fxTiming.createNestedObject("show"), stripOutput.showTiming());
+    fxTiming["wireTime"] = stripOutput.frameWireTime();         //estimated time to shift a frame out, us
+    JsonArray outputs = fxTiming.createNestedArray("outputs");
+    for (uint8_t x = 0; x < stripOutput.outputCount(); x++) {
+        const LedOutput &out = stripOutput.output(x);
+        JsonObject jsOut = outputs.createNestedObject();
+        jsOut["pin"] = out.pin;
+        jsOut["start"] = out.start;
+        jsOut["size"] = out.size;
+        jsOut["wireTime"] = StripOutput::wireTime(out.size);
+    }
+    JsonArray fxTimingEffects = fxTiming.createNestedArray("effects");
+    for (uint16_t x = 0; x < fxRegistry.size(); x++) {
+        const LedEffect *lfx = fxRegistry.getEffect(x);
+        if (lfx->runTiming().getCount() == 0 && lfx->windDownTiming().getCount() == 0)
+            continue;
+        JsonObject fxt = fxTimingEffects.createNestedObject();
+        fxt["name"] = lfx->name();
+        fxt["budget"] = lfx->frameBudget()*1000;
+        fxt["missed"] = lfx->missedFrameCount();
+        timingStatsJson(fxt.createNestedObject("run"), lfx->runTiming());
+        if (lfx->windDownTiming().getCount() > 0)
+            timingStatsJson(fxt.createNestedObject("windDown"), lfx->windDownTiming());
+    }
     // Time
     JsonObject time = doc.createNestedObject("time");
     time["ntpSync"] = timeStatus();
@@ -417,6 +461,11 @@ size_t web::handleGetStatus(WiFiClient *client, String *uri, String *hd, String
     doc["vcc"] = controllerVoltage();
     doc["minVcc"] = minVcc;
     doc["maxVcc"] = maxVcc;
+    JsonObject power = doc.createNestedObject("power");
+    power["budget"] = stripOutput.powerBudget();            //mA
+    power["estimate"] = stripOutput.powerEstimate();        //mA, last frame pushed
+    power["limited"] = stripOutput.isPowerLimited();        //whether the last frame pushed was dimmed to fit the budget
+    power["limitedFrames"] = stripOutput.powerLimitedCount();
     doc["boardMinTemp"] = minTemp;
     doc["boardMaxTemp"] = maxTemp;
     doc["overallStatus"] = getSysStatus();
@@ -452,8 +501,9 @@ size_t web::handlePutConfig(WiFiClient *client, String *uri, String *hd, String
     if (error)
         return handleInternalError(client, uri, error.c_str());
 
-    StaticJsonDocument<128> resp;
+    StaticJsonDocument<160> resp;
     const char strAuto[] = "auto";
+    const char strCrossfade[] = "crossfade";
     const char strEffect[] = "effect";
     const char strHoliday[] = "holiday";
     const char strBrightness[] = "brightness";
@@ -464,6 +514,11 @@ size_t web::handlePutConfig(WiFiClient *client, String *uri, String *hd, String
         fxRegistry.autoRoll(autoAdvance);
         upd[strAuto] = autoAdvance;
     }
+    if (doc.containsKey(strCrossfade)) {
+        uint16_t xfade = doc[strCrossfade].as<uint16_t>();
+        fxRegistry.crossfade(xfade);
+        upd[strCrossfade] = xfade;
+    }
     if (doc.containsKey(strEffect)) {
         uint16_t nextFx = doc[strEffect].as<uint16_t >();
         fxRegistry.nextEffectPos(nextFx);
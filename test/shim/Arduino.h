@@ -0,0 +1,217 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the Arduino core - only the subset the effects engine uses. Time is the host's monotonic clock plus a
+// virtual offset: delay() and yield() advance the clock rather than sleeping, such that effects pacing themselves on millis() progress
+// at full host speed while the time measured around a piece of code (micros) remains real.
+
+#ifndef TEEN_LIGHTFX_SHIM_ARDUINO_H
+#define TEEN_LIGHTFX_SHIM_ARDUINO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <cmath>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sys/types.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH    0x1
+#define LOW     0x0
+#define DEC     10
+#define HEX     16
+#define OCT     8
+#define BIN     2
+#define INPUT   0x0
+#define OUTPUT  0x1
+#define PI      3.1415926535897932384626433832795
+#define LEDR    27
+#define LEDG    25
+#define LEDB    26
+#define A0      26
+#define A1      27
+#define A2      28
+#define A3      29
+#define ADC_RESOLUTION  12
+
+#define PROGMEM
+#define PGM_P   const char *
+#define PSTR(s) (s)
+#define F(s)    (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+#define memcpy_P    memcpy
+class __FlashStringHelper;
+
+template<class T, class L> auto min(const T &a, const L &b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template<class T, class L> auto max(const T &a, const L &b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+#define constrain(amt, low, high)   ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x)       ((x)*(x))
+#define radians(deg)    ((deg)*PI/180.0)
+#define degrees(rad)    ((rad)*180.0/PI)
+#define bit(b)          (1UL << (b))
+#define bitRead(value, b)   (((value) >> (b)) & 0x01)
+#define lowByte(w)      ((uint8_t)((w) & 0xff))
+#define highByte(w)     ((uint8_t)((w) >> 8))
+
+namespace shim {
+    inline std::atomic<uint64_t> clockOffsetUs {0};
+    inline uint64_t clockUs() {
+        static const auto origin = std::chrono::steady_clock::now();
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count() + clockOffsetUs;
+    }
+    /**
+     * Moves the virtual clock forward - the host equivalent of waiting
+     * @param us time to advance, in microseconds
+     */
+    inline void advanceClock(uint64_t us) {
+        clockOffsetUs += us;
+        std::this_thread::yield();
+    }
+}
+
+inline unsigned long millis() { return (unsigned long)(shim::clockUs() / 1000); }
+inline unsigned long micros() { return (unsigned long)shim::clockUs(); }
+inline void delay(unsigned long ms) { shim::advanceClock(ms * 1000ull); }
+inline void delayMicroseconds(unsigned int us) { shim::advanceClock(us); }
+inline void yield() { shim::advanceClock(1000); }
+
+//CMSIS barrier and event intrinsics - the core headers bring them in on the board. Waiting for an event may return spuriously, as on the board
+inline void __DMB() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+inline void __SEV() {}
+inline void __WFE() { std::this_thread::sleep_for(std::chrono::microseconds(20)); }
+
+inline long random(long howbig) { return howbig > 0 ? ::random() % howbig : 0; }
+inline long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+inline void randomSeed(unsigned long seed) { if (seed) ::srandom(seed); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) { return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin; }
+
+//the board's analog/digital pins - nothing attached on the host
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline int analogRead(uint8_t) { return 0; }
+inline void analogWrite(uint8_t, int) {}
+inline void analogReadResolution(int) {}
+inline unsigned int adc_get_selected_input() { return 0; }
+inline void adc_select_input(unsigned int) {}
+inline uint16_t adc_read() { return 0; }
+
+class String {
+    std::string s;
+public:
+    String() = default;
+    String(const char *cstr) : s(cstr ? cstr : "") {}
+    String(const std::string &str) : s(str) {}
+    explicit String(char c) : s(1, c) {}
+    explicit String(int val) : s(std::to_string(val)) {}
+    explicit String(unsigned int val) : s(std::to_string(val)) {}
+    explicit String(long val) : s(std::to_string(val)) {}
+    explicit String(unsigned long val) : s(std::to_string(val)) {}
+    const char *c_str() const { return s.c_str(); }
+    unsigned int length() const { return s.length(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+    char charAt(unsigned int index) const { return index < s.length() ? s[index] : 0; }
+    bool concat(const char *cstr, unsigned int len) { s.append(cstr, len); return true; }
+    bool concat(const char *cstr) { if (cstr) s.append(cstr); return true; }
+    bool concat(const String &str) { s.append(str.s); return true; }
+    bool concat(char c) { s.push_back(c); return true; }
+    String &operator+=(const char *cstr) { concat(cstr); return *this; }
+    String &operator+=(const String &str) { concat(str); return *this; }
+    String &operator+=(char c) { concat(c); return *this; }
+    bool operator==(const String &rhs) const { return s == rhs.s; }
+    bool operator==(const char *rhs) const { return s == (rhs ? rhs : ""); }
+    bool operator!=(const String &rhs) const { return s != rhs.s; }
+    bool equalsIgnoreCase(const String &rhs) const { return strcasecmp(s.c_str(), rhs.s.c_str()) == 0; }
+    int indexOf(char c) const { auto p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned int from) const { return from < s.length() ? String(s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const { return from < s.length() ? String(s.substr(from, to - from)) : String(); }
+    long toInt() const { return strtol(s.c_str(), nullptr, 10); }
+    void toLowerCase() { for (auto &c : s) c = (char)tolower(c); }
+    void toUpperCase() { for (auto &c : s) c = (char)toupper(c); }
+};
+
+class Print;
+class Printable {
+public:
+    virtual ~Printable() = default;
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+        size_t n = 0;
+        while (size--)
+            n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t print(const char *str) { return write(str); }
+    size_t print(const String &str) { return write(str.c_str()); }
+    size_t print(const __FlashStringHelper *str) { return write(reinterpret_cast<const char *>(str)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(const Printable &x) { return x.printTo(*this); }
+    size_t print(long val, int base = 10) { return base == 10 && val < 0 ? print('-') + print((unsigned long)-val, base) : print((unsigned long)val, base); }
+    size_t print(unsigned long val, int base = 10) {
+        char buf[8 * sizeof(long) + 1];
+        char *str = &buf[sizeof(buf) - 1];
+        *str = '\0';
+        do {
+            const char c = (char)(val % base);
+            val /= base;
+            *--str = c < 10 ? c + '0' : c + 'A' - 10;
+        } while (val);
+        return write(str);
+    }
+    size_t print(int val, int base = 10) { return print((long)val, base); }
+    size_t print(unsigned int val, int base = 10) { return print((unsigned long)val, base); }
+    size_t print(double val, int digits = 2) { return printf("%.*f", digits, val); }
+    size_t println() { return write("\r\n"); }
+    template<typename T> size_t println(const T &val) { return print(val) + println(); }
+    template<typename T> size_t println(const T &val, int fmt) { return print(val, fmt) + println(); }
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[256];
+        va_list args;
+        va_start(args, fmt);
+        int len = vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        return len > 0 ? write((const uint8_t *)buf, min((size_t)len, sizeof(buf) - 1)) : 0;
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+};
+
+/**
+ * Serial console - goes to the host's standard output
+ */
+class HostSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    explicit operator bool() const { return true; }
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+    using Print::write;
+    void flush() { fflush(stdout); }
+};
+
+inline HostSerial Serial;
+
+#endif //TEEN_LIGHTFX_SHIM_ARDUINO_H
@@ -0,0 +1,24 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the ECC608 secure element - reported absent, random numbers fall back to random()
+
+#ifndef TEEN_LIGHTFX_SHIM_ARDUINOECCX08_H
+#define TEEN_LIGHTFX_SHIM_ARDUINOECCX08_H
+
+#include <Arduino.h>
+
+class ECCX08Class {
+public:
+    int begin() { return 0; }
+    void end() {}
+    String serialNumber() { return String(); }
+    long random(long max) { return ::random(max); }
+    long random(long min, long max) { return ::random(min, max); }
+    int locked() { return 0; }
+    int writeConfiguration(const uint8_t[]) { return 0; }
+    int lock() { return 0; }
+};
+
+inline ECCX08Class ECCX08;
+
+#endif //TEEN_LIGHTFX_SHIM_ARDUINOECCX08_H
@@ -0,0 +1,25 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the on-board IMU - no sensor on the host
+
+#ifndef TEEN_LIGHTFX_SHIM_ARDUINO_LSM6DSOX_H
+#define TEEN_LIGHTFX_SHIM_ARDUINO_LSM6DSOX_H
+
+#include <Arduino.h>
+
+class LSM6DSOXClass {
+public:
+    int begin() { return 0; }
+    void end() {}
+    int temperatureAvailable() { return 0; }
+    int readTemperature(int &t) { t = 0; return 0; }
+    int readTemperatureFloat(float &t) { t = 0.0f; return 0; }
+    int accelerationAvailable() { return 0; }
+    int readAcceleration(float &x, float &y, float &z) { x = y = z = 0.0f; return 0; }
+    int gyroscopeAvailable() { return 0; }
+    int readGyroscope(float &x, float &y, float &z) { x = y = z = 0.0f; return 0; }
+};
+
+inline LSM6DSOXClass IMU;
+
+#endif //TEEN_LIGHTFX_SHIM_ARDUINO_LSM6DSOX_H
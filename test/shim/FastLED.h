@@ -0,0 +1,1212 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for FastLED 3.6 - the subset of the API the effects engine uses. The math (lib8tion, color conversion, blending,
+// palettes) follows FastLED's portable C implementations with FASTLED_SCALE8_FIXED, such that frames rendered on the host match the
+// board's. Controllers do not drive any pin: FastLED.show() hands the scaled pixels to the registered controllers - e.g. the benchmark's
+// recording sink - and nothing else.
+
+#ifndef TEEN_LIGHTFX_SHIM_FASTLED_H
+#define TEEN_LIGHTFX_SHIM_FASTLED_H
+
+#include <Arduino.h>
+
+#define FASTLED_VERSION     3006000
+#define FASTLED_SCALE8_FIXED    1
+#define FL_PROGMEM
+#define FASTLED_NAMESPACE_BEGIN
+#define FASTLED_NAMESPACE_END
+#define FASTLED_USING_NAMESPACE
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+typedef uint16_t accum88;
+typedef int16_t saccum87;
+
+//~ lib8tion ------------------------------
+#define GET_MILLIS  millis
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {
+    return (((uint16_t)i) * (1 + (uint16_t)scale)) >> 8;
+}
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+    return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+inline uint8_t scale8_LEAVING_R1_DIRTY(uint8_t i, fract8 scale) { return scale8(i, scale); }
+inline uint8_t scale8_video_LEAVING_R1_DIRTY(uint8_t i, fract8 scale) { return scale8_video(i, scale); }
+inline void nscale8_LEAVING_R1_DIRTY(uint8_t &i, fract8 scale) { i = scale8(i, scale); }
+inline void cleanup_R1() {}
+inline void nscale8x3(uint8_t &r, uint8_t &g, uint8_t &b, fract8 scale) {
+    const uint16_t scaleFixed = scale + 1;
+    r = (((uint16_t)r) * scaleFixed) >> 8;
+    g = (((uint16_t)g) * scaleFixed) >> 8;
+    b = (((uint16_t)b) * scaleFixed) >> 8;
+}
+inline void nscale8x3_video(uint8_t &r, uint8_t &g, uint8_t &b, fract8 scale) {
+    const uint8_t nonZeroScale = (scale != 0) ? 1 : 0;
+    r = (r == 0) ? 0 : (((int)r * (int)scale) >> 8) + nonZeroScale;
+    g = (g == 0) ? 0 : (((int)g * (int)scale) >> 8) + nonZeroScale;
+    b = (b == 0) ? 0 : (((int)b * (int)scale) >> 8) + nonZeroScale;
+}
+inline uint16_t scale16(uint16_t i, fract16 scale) {
+    return ((uint32_t)i * (1 + (uint32_t)scale)) >> 16;
+}
+inline uint16_t scale16by8(uint16_t i, fract8 scale) {
+    return (i * (1 + ((uint16_t)scale))) >> 8;
+}
+inline uint8_t qadd8(uint8_t i, uint8_t j) { const unsigned t = i + j; return t > 255 ? 255 : t; }
+inline int8_t qadd7(int8_t i, int8_t j) { const int t = i + j; return t > 127 ? 127 : (t < -128 ? -128 : t); }
+inline uint8_t qsub8(uint8_t i, uint8_t j) { const int t = i - j; return t < 0 ? 0 : t; }
+inline uint8_t qmul8(uint8_t i, uint8_t j) { const unsigned p = (unsigned)i * j; return p > 255 ? 255 : p; }
+inline uint8_t add8(uint8_t i, uint8_t j) { return i + j; }
+inline uint8_t sub8(uint8_t i, uint8_t j) { return i - j; }
+inline uint8_t mul8(uint8_t i, uint8_t j) { return ((unsigned)i * j) & 0xFF; }
+inline uint8_t avg8(uint8_t i, uint8_t j) { return (i + j) >> 1; }
+inline uint16_t avg16(uint16_t i, uint16_t j) { return ((uint32_t)i + (uint32_t)j) >> 1; }
+inline int8_t avg7(int8_t i, int8_t j) { return ((i + j) >> 1) + (i & 0x1); }
+inline int8_t abs8(int8_t i) { return i < 0 ? -i : i; }
+inline uint8_t addmod8(uint8_t a, uint8_t b, uint8_t m) { a += b; while (a >= m) a -= m; return a; }
+inline uint8_t submod8(uint8_t a, uint8_t b, uint8_t m) { a -= b; while (a >= m) a -= m; return a; }
+inline uint8_t lsrX4(uint8_t dividend) { return dividend >> 4; }
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+    uint16_t partial = (a << 8) | b;
+    partial += (b * amountOfB);
+    partial -= (a * amountOfB);
+    return partial >> 8;
+}
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {
+    if (b > a)
+        return a + scale8(b - a, frac);
+    return a - scale8(a - b, frac);
+}
+inline uint16_t lerp16by16(uint16_t a, uint16_t b, fract16 frac) {
+    if (b > a)
+        return a + scale16(b - a, frac);
+    return a - scale16(a - b, frac);
+}
+inline uint8_t map8(uint8_t in, uint8_t rangeStart, uint8_t rangeEnd) {
+    return scale8(in, rangeEnd - rangeStart) + rangeStart;
+}
+inline uint8_t dim8_raw(uint8_t x) { return scale8(x, x); }
+inline uint8_t dim8_video(uint8_t x) { return scale8_video(x, x); }
+inline uint8_t dim8_lin(uint8_t x) {
+    if (x & 0x80)
+        return scale8(x, x);
+    x += 1;
+    x /= 2;
+    return x;
+}
+inline uint8_t brighten8_raw(uint8_t x) { const uint8_t ix = 255 - x; return 255 - scale8(ix, ix); }
+inline uint8_t brighten8_video(uint8_t x) { const uint8_t ix = 255 - x; return 255 - scale8_video(ix, ix); }
+inline uint16_t sqrt16(uint16_t x) {
+    if (x <= 1)
+        return x;
+    uint8_t low = 1;
+    uint8_t hi, mid;
+    if (x > 7904)
+        hi = 255;
+    else
+        hi = (x >> 5) + 8;
+    do {
+        mid = (low + hi) >> 1;
+        if ((uint16_t)(mid * mid) > x)
+            hi = mid - 1;
+        else {
+            if (mid == 255)
+                return 255;
+            low = mid + 1;
+        }
+    } while (hi >= low);
+    return low - 1;
+}
+
+inline uint8_t ease8InOutQuad(uint8_t i) {
+    uint8_t j = i;
+    if (j & 0x80)
+        j = 255 - j;
+    uint8_t jj = scale8(j, j);
+    uint8_t jj2 = jj << 1;
+    if (i & 0x80)
+        jj2 = 255 - jj2;
+    return jj2;
+}
+inline uint16_t ease16InOutQuad(uint16_t i) {
+    uint16_t j = i;
+    if (j & 0x8000)
+        j = 65535 - j;
+    uint16_t jj = scale16(j, j);
+    uint16_t jj2 = jj << 1;
+    if (i & 0x8000)
+        jj2 = 65535 - jj2;
+    return jj2;
+}
+inline uint8_t ease8InOutCubic(uint8_t i) {
+    const uint8_t ii = scale8(i, i);
+    const uint8_t iii = scale8(ii, i);
+    const uint16_t r1 = (3 * (uint16_t)ii) - (2 * (uint16_t)iii);
+    return (r1 & 0x300) ? 255 : r1;
+}
+inline uint8_t ease8InOutApprox(uint8_t i) {
+    if (i < 64)
+        i /= 2;
+    else if (i > (255 - 64)) {
+        i = 255 - i;
+        i /= 2;
+        i = 255 - i;
+    } else {
+        i -= 64;
+        i += (i / 2);
+        i += 32;
+    }
+    return i;
+}
+inline uint8_t triwave8(uint8_t in) {
+    if (in & 0x80)
+        in = 255 - in;
+    return in << 1;
+}
+inline uint8_t quadwave8(uint8_t in) { return ease8InOutQuad(triwave8(in)); }
+inline uint8_t cubicwave8(uint8_t in) { return ease8InOutCubic(triwave8(in)); }
+inline uint8_t squarewave8(uint8_t in, uint8_t pulseWidth = 128) { return in < pulseWidth || pulseWidth == 255 ? 255 : 0; }
+
+inline int16_t sin16(uint16_t theta) {
+    static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+    static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+    uint16_t offset = (theta & 0x3FFF) >> 3;
+    if (theta & 0x4000)
+        offset = 2047 - offset;
+    const uint8_t section = offset / 256;
+    const uint16_t b = base[section];
+    const uint8_t m = slope[section];
+    const uint8_t secoffset8 = (uint8_t)(offset) / 2;
+    const uint16_t mx = m * secoffset8;
+    int16_t y = mx + b;
+    if (theta & 0x8000)
+        y = -y;
+    return y;
+}
+inline int16_t cos16(uint16_t theta) { return sin16(theta + 16384); }
+inline uint8_t sin8(uint8_t theta) {
+    static const uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+    uint8_t offset = theta;
+    if (theta & 0x40)
+        offset = (uint8_t)255 - offset;
+    offset &= 0x3F;
+    uint8_t secoffset = offset & 0x0F;
+    if (theta & 0x40)
+        ++secoffset;
+    const uint8_t section = offset >> 4;
+    const uint8_t *p = b_m16_interleave + section * 2;
+    const uint8_t b = *p++;
+    const uint8_t m16 = *p;
+    const uint8_t mx = (m16 * secoffset) >> 4;
+    int8_t y = mx + b;
+    if (theta & 0x80)
+        y = -y;
+    y += 128;
+    return y;
+}
+inline uint8_t cos8(uint8_t theta) { return sin8(theta + 64); }
+
+//~ random numbers - FastLED's 16 bit LCG
+namespace shim {
+    inline uint16_t rand16seed = 1337;
+}
+inline uint8_t random8() {
+    shim::rand16seed = (shim::rand16seed * 2053) + 13849;
+    return (uint8_t)(((uint8_t)(shim::rand16seed & 0xFF)) + ((uint8_t)(shim::rand16seed >> 8)));
+}
+inline uint8_t random8(uint8_t lim) { return (random8() * lim) >> 8; }
+inline uint8_t random8(uint8_t min, uint8_t lim) { return random8(lim - min) + min; }
+inline uint16_t random16() {
+    shim::rand16seed = (shim::rand16seed * 2053) + 13849;
+    return shim::rand16seed;
+}
+inline uint16_t random16(uint16_t lim) { return ((uint32_t)lim * random16()) >> 16; }
+inline uint16_t random16(uint16_t min, uint16_t lim) { return random16(lim - min) + min; }
+inline void random16_set_seed(uint16_t seed) { shim::rand16seed = seed; }
+inline uint16_t random16_get_seed() { return shim::rand16seed; }
+inline void random16_add_entropy(uint16_t entropy) { shim::rand16seed += entropy; }
+
+//~ beats - the millisecond timer truncated to 32 bits, as on the board
+inline uint16_t beat88(accum88 bpm88, uint32_t timebase = 0) {
+    return (((uint32_t)GET_MILLIS() - timebase) * bpm88 * 280) >> 16;
+}
+inline uint16_t beat16(accum88 bpm, uint32_t timebase = 0) {
+    if (bpm < 256)
+        bpm <<= 8;
+    return beat88(bpm, timebase);
+}
+inline uint8_t beat8(accum88 bpm, uint32_t timebase = 0) { return beat16(bpm, timebase) >> 8; }
+inline uint16_t beatsin88(accum88 bpm88, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phaseOffset = 0) {
+    const uint16_t beatSin = sin16(beat88(bpm88, timebase) + phaseOffset) + 32768;
+    return lowest + scale16(beatSin, highest - lowest);
+}
+inline uint16_t beatsin16(accum88 bpm, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phaseOffset = 0) {
+    const uint16_t beatSin = sin16(beat16(bpm, timebase) + phaseOffset) + 32768;
+    return lowest + scale16(beatSin, highest - lowest);
+}
+inline uint8_t beatsin8(accum88 bpm, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phaseOffset = 0) {
+    const uint8_t beatSin = sin8(beat8(bpm, timebase) + phaseOffset);
+    return lowest + scale8(beatSin, highest - lowest);
+}
+
+//~ periodic timers
+template<unsigned long (*TIMER)(), unsigned long DIV> class CEveryNTimePeriods {
+    unsigned long prevTrigger;
+    unsigned long period;
+public:
+    explicit CEveryNTimePeriods(unsigned long p) : period(p) { reset(); }
+    static unsigned long getTime() { return TIMER() / DIV; }
+    unsigned long getPeriod() const { return period; }
+    void setPeriod(unsigned long p) { period = p; }
+    unsigned long getElapsed() const { return getTime() - prevTrigger; }
+    void reset() { prevTrigger = getTime(); }
+    void trigger() { prevTrigger = getTime() - period; }
+    bool ready() {
+        const bool isReady = getElapsed() >= period;
+        if (isReady)
+            reset();
+        return isReady;
+    }
+    explicit operator bool() { return ready(); }
+};
+typedef CEveryNTimePeriods<millis, 1> CEveryNMillis;
+typedef CEveryNTimePeriods<millis, 1000> CEveryNSeconds;
+typedef CEveryNTimePeriods<millis, 60000> CEveryNMinutes;
+#define SHIM_CONCAT2(a, b)  a##b
+#define SHIM_CONCAT(a, b)   SHIM_CONCAT2(a, b)
+#define EVERY_N_MILLIS_I(NAME, N)   static CEveryNMillis NAME(N); if (NAME)
+#define EVERY_N_SECONDS_I(NAME, N)  static CEveryNSeconds NAME(N); if (NAME)
+#define EVERY_N_MINUTES_I(NAME, N)  static CEveryNMinutes NAME(N); if (NAME)
+#define EVERY_N_MILLIS(N)   EVERY_N_MILLIS_I(SHIM_CONCAT(perMillis, __COUNTER__), N)
+#define EVERY_N_MILLISECONDS(N) EVERY_N_MILLIS(N)
+#define EVERY_N_SECONDS(N)  EVERY_N_SECONDS_I(SHIM_CONCAT(perSeconds, __COUNTER__), N)
+#define EVERY_N_MINUTES(N)  EVERY_N_MINUTES_I(SHIM_CONCAT(perMinutes, __COUNTER__), N)
+
+//~ colors ------------------------------
+typedef enum {
+    TypicalSMD5050 = 0xFFB0F0, TypicalLEDStrip = 0xFFB0F0, Typical8mmPixel = 0xFFE08C, TypicalPixelString = 0xFFE08C, UncorrectedColor = 0xFFFFFF
+} LEDColorCorrection;
+
+typedef enum {
+    Candle = 0xFF9329, Tungsten40W = 0xFFC58F, Tungsten100W = 0xFFD6AA, Halogen = 0xFFF1E0, CarbonArc = 0xFFFAF4, HighNoonSun = 0xFFFFFB,
+    DirectSunlight = 0xFFFFFF, OvercastSky = 0xC9E2FF, ClearBlueSky = 0x409CFF, WarmFluorescent = 0xFFF4E5, StandardFluorescent = 0xF4FFFA,
+    CoolWhiteFluorescent = 0xD4EBFF, FullSpectrumFluorescent = 0xFFF4F2, GrowLightFluorescent = 0xFFEFF7, BlackLightFluorescent = 0xA700FF,
+    MercuryVapor = 0xD8F7FF, SodiumVapor = 0xFFD1B2, MetalHalide = 0xF2FCFF, HighPressureSodium = 0xFFB74C, UncorrectedTemperature = 0xFFFFFF
+} ColorTemperature;
+
+typedef enum {
+    HUE_RED = 0, HUE_ORANGE = 32, HUE_YELLOW = 64, HUE_GREEN = 96, HUE_AQUA = 128, HUE_BLUE = 160, HUE_PURPLE = 192, HUE_PINK = 224
+} HSVHue;
+
+struct CHSV {
+    union {
+        struct {
+            union { uint8_t hue; uint8_t h; };
+            union { uint8_t saturation; uint8_t sat; uint8_t s; };
+            union { uint8_t value; uint8_t val; uint8_t v; };
+        };
+        uint8_t raw[3];
+    };
+
+    CHSV() = default;
+    constexpr CHSV(uint8_t ih, uint8_t is, uint8_t iv) : h(ih), s(is), v(iv) {}
+    inline uint8_t &operator[](uint8_t x) { return raw[x]; }
+    inline const uint8_t &operator[](uint8_t x) const { return raw[x]; }
+    inline CHSV &setHSV(uint8_t ih, uint8_t is, uint8_t iv) { h = ih; s = is; v = iv; return *this; }
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb);
+
+struct CRGB {
+    union {
+        struct {
+            union { uint8_t r; uint8_t red; };
+            union { uint8_t g; uint8_t green; };
+            union { uint8_t b; uint8_t blue; };
+        };
+        uint8_t raw[3];
+    };
+
+    typedef enum {
+        AliceBlue = 0xF0F8FF, Amethyst = 0x9966CC, AntiqueWhite = 0xFAEBD7, Aqua = 0x00FFFF, Aquamarine = 0x7FFFD4, Azure = 0xF0FFFF,
+        Beige = 0xF5F5DC, Bisque = 0xFFE4C4, Black = 0x000000, BlanchedAlmond = 0xFFEBCD, Blue = 0x0000FF, BlueViolet = 0x8A2BE2,
+        Brown = 0xA52A2A, BurlyWood = 0xDEB887, CadetBlue = 0x5F9EA0, Chartreuse = 0x7FFF00, Chocolate = 0xD2691E, Coral = 0xFF7F50,
+        CornflowerBlue = 0x6495ED, Cornsilk = 0xFFF8DC, Crimson = 0xDC143C, Cyan = 0x00FFFF, DarkBlue = 0x00008B, DarkCyan = 0x008B8B,
+        DarkGoldenrod = 0xB8860B, DarkGray = 0xA9A9A9, DarkGrey = 0xA9A9A9, DarkGreen = 0x006400, DarkKhaki = 0xBDB76B,
+        DarkMagenta = 0x8B008B, DarkOliveGreen = 0x556B2F, DarkOrange = 0xFF8C00, DarkOrchid = 0x9932CC, DarkRed = 0x8B0000,
+        DarkSalmon = 0xE9967A, DarkSeaGreen = 0x8FBC8F, DarkSlateBlue = 0x483D8B, DarkSlateGray = 0x2F4F4F, DarkSlateGrey = 0x2F4F4F,
+        DarkTurquoise = 0x00CED1, DarkViolet = 0x9400D3, DeepPink = 0xFF1493, DeepSkyBlue = 0x00BFFF, DimGray = 0x696969,
+        DimGrey = 0x696969, DodgerBlue = 0x1E90FF, FireBrick = 0xB22222, FloralWhite = 0xFFFAF0, ForestGreen = 0x228B22,
+        Fuchsia = 0xFF00FF, Gainsboro = 0xDCDCDC, GhostWhite = 0xF8F8FF, Gold = 0xFFD700, Goldenrod = 0xDAA520, Gray = 0x808080,
+        Grey = 0x808080, Green = 0x008000, GreenYellow = 0xADFF2F, Honeydew = 0xF0FFF0, HotPink = 0xFF69B4, IndianRed = 0xCD5C5C,
+        Indigo = 0x4B0082, Ivory = 0xFFFFF0, Khaki = 0xF0E68C, Lavender = 0xE6E6FA, LavenderBlush = 0xFFF0F5, LawnGreen = 0x7CFC00,
+        LemonChiffon = 0xFFFACD, LightBlue = 0xADD8E6, LightCoral = 0xF08080, LightCyan = 0xE0FFFF, LightGoldenrodYellow = 0xFAFAD2,
+        LightGreen = 0x90EE90, LightGrey = 0xD3D3D3, LightPink = 0xFFB6C1, LightSalmon = 0xFFA07A, LightSeaGreen = 0x20B2AA,
+        LightSkyBlue = 0x87CEFA, LightSlateGray = 0x778899, LightSlateGrey = 0x778899, LightSteelBlue = 0xB0C4DE,
+        LightYellow = 0xFFFFE0, Lime = 0x00FF00, LimeGreen = 0x32CD32, Linen = 0xFAF0E6, Magenta = 0xFF00FF, Maroon = 0x800000,
+        MediumAquamarine = 0x66CDAA, MediumBlue = 0x0000CD, MediumOrchid = 0xBA55D3, MediumPurple = 0x9370DB,
+        MediumSeaGreen = 0x3CB371, MediumSlateBlue = 0x7B68EE, MediumSpringGreen = 0x00FA9A, MediumTurquoise = 0x48D1CC,
+        MediumVioletRed = 0xC71585, MidnightBlue = 0x191970, MintCream = 0xF5FFFA, MistyRose = 0xFFE4E1, Moccasin = 0xFFE4B5,
+        NavajoWhite = 0xFFDEAD, Navy = 0x000080, OldLace = 0xFDF5E6, Olive = 0x808000, OliveDrab = 0x6B8E23, Orange = 0xFFA500,
+        OrangeRed = 0xFF4500, Orchid = 0xDA70D6, PaleGoldenrod = 0xEEE8AA, PaleGreen = 0x98FB98, PaleTurquoise = 0xAFEEEE,
+        PaleVioletRed = 0xDB7093, PapayaWhip = 0xFFEFD5, PeachPuff = 0xFFDAB9, Peru = 0xCD853F, Pink = 0xFFC0CB, Plaid = 0xCC5533,
+        Plum = 0xDDA0DD, PowderBlue = 0xB0E0E6, Purple = 0x800080, Red = 0xFF0000, RosyBrown = 0xBC8F8F, RoyalBlue = 0x4169E1,
+        SaddleBrown = 0x8B4513, Salmon = 0xFA8072, SandyBrown = 0xF4A460, SeaGreen = 0x2E8B57, Seashell = 0xFFF5EE, Sienna = 0xA0522D,
+        Silver = 0xC0C0C0, SkyBlue = 0x87CEEB, SlateBlue = 0x6A5ACD, SlateGray = 0x708090, SlateGrey = 0x708090, Snow = 0xFFFAFA,
+        SpringGreen = 0x00FF7F, SteelBlue = 0x4682B4, Tan = 0xD2B48C, Teal = 0x008080, Thistle = 0xD8BFD8, Tomato = 0xFF6347,
+        Turquoise = 0x40E0D0, Violet = 0xEE82EE, Wheat = 0xF5DEB3, White = 0xFFFFFF, WhiteSmoke = 0xF5F5F5, Yellow = 0xFFFF00,
+        YellowGreen = 0x9ACD32, FairyLight = 0xFFE42D, FairyLightNCC = 0xFF9D2A
+    } HTMLColorCode;
+
+    CRGB() = default;
+    constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+    constexpr CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+    constexpr CRGB(LEDColorCorrection colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+    constexpr CRGB(ColorTemperature colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+    constexpr CRGB(HTMLColorCode colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+    CRGB(const CHSV &rhs) { hsv2rgb_rainbow(rhs, *this); }
+    CRGB(const CRGB &rhs) = default;
+    CRGB &operator=(const CRGB &rhs) = default;
+    inline CRGB &operator=(const uint32_t colorcode) { r = (colorcode >> 16) & 0xFF; g = (colorcode >> 8) & 0xFF; b = colorcode & 0xFF; return *this; }
+    inline CRGB &operator=(const CHSV &rhs) { hsv2rgb_rainbow(rhs, *this); return *this; }
+    inline uint8_t &operator[](uint8_t x) { return raw[x]; }
+    inline const uint8_t &operator[](uint8_t x) const { return raw[x]; }
+
+    inline CRGB &setRGB(uint8_t nr, uint8_t ng, uint8_t nb) { r = nr; g = ng; b = nb; return *this; }
+    inline CRGB &setHSV(uint8_t hue, uint8_t sat, uint8_t val) { hsv2rgb_rainbow(CHSV(hue, sat, val), *this); return *this; }
+    inline CRGB &setHue(uint8_t hue) { hsv2rgb_rainbow(CHSV(hue, 255, 255), *this); return *this; }
+    inline CRGB &setColorCode(uint32_t colorcode) { return *this = colorcode; }
+
+    inline CRGB &operator+=(const CRGB &rhs) { r = qadd8(r, rhs.r); g = qadd8(g, rhs.g); b = qadd8(b, rhs.b); return *this; }
+    inline CRGB &addToRGB(uint8_t d) { r = qadd8(r, d); g = qadd8(g, d); b = qadd8(b, d); return *this; }
+    inline CRGB &operator-=(const CRGB &rhs) { r = qsub8(r, rhs.r); g = qsub8(g, rhs.g); b = qsub8(b, rhs.b); return *this; }
+    inline CRGB &subtractFromRGB(uint8_t d) { r = qsub8(r, d); g = qsub8(g, d); b = qsub8(b, d); return *this; }
+    inline CRGB &operator--() { subtractFromRGB(1); return *this; }
+    inline CRGB operator--(int) { CRGB retval(*this); --(*this); return retval; }
+    inline CRGB &operator++() { addToRGB(1); return *this; }
+    inline CRGB operator++(int) { CRGB retval(*this); ++(*this); return retval; }
+    inline CRGB &operator/=(uint8_t d) { r /= d; g /= d; b /= d; return *this; }
+    inline CRGB &operator>>=(uint8_t d) { r >>= d; g >>= d; b >>= d; return *this; }
+    inline CRGB &operator*=(uint8_t d) { r = qmul8(r, d); g = qmul8(g, d); b = qmul8(b, d); return *this; }
+    inline CRGB &nscale8_video(uint8_t scaledown) { nscale8x3_video(r, g, b, scaledown); return *this; }
+    inline CRGB &operator%=(uint8_t scaledown) { nscale8x3_video(r, g, b, scaledown); return *this; }
+    inline CRGB &fadeLightBy(uint8_t fadefactor) { nscale8x3_video(r, g, b, 255 - fadefactor); return *this; }
+    inline CRGB &nscale8(uint8_t scaledown) { nscale8x3(r, g, b, scaledown); return *this; }
+    inline CRGB &nscale8(const CRGB &scaledown) { r = ::scale8(r, scaledown.r); g = ::scale8(g, scaledown.g); b = ::scale8(b, scaledown.b); return *this; }
+    inline CRGB scale8(uint8_t scaledown) const { CRGB out = *this; nscale8x3(out.r, out.g, out.b, scaledown); return out; }
+    inline CRGB scale8(const CRGB &scaledown) const { return {::scale8(r, scaledown.r), ::scale8(g, scaledown.g), ::scale8(b, scaledown.b)}; }
+    inline CRGB &fadeToBlackBy(uint8_t fadefactor) { nscale8x3(r, g, b, 255 - fadefactor); return *this; }
+    inline CRGB &operator|=(const CRGB &rhs) { if (rhs.r > r) r = rhs.r; if (rhs.g > g) g = rhs.g; if (rhs.b > b) b = rhs.b; return *this; }
+    inline CRGB &operator|=(uint8_t d) { if (d > r) r = d; if (d > g) g = d; if (d > b) b = d; return *this; }
+    inline CRGB &operator&=(const CRGB &rhs) { if (rhs.r < r) r = rhs.r; if (rhs.g < g) g = rhs.g; if (rhs.b < b) b = rhs.b; return *this; }
+    inline CRGB &operator&=(uint8_t d) { if (d < r) r = d; if (d < g) g = d; if (d < b) b = d; return *this; }
+    inline explicit operator bool() const { return r || g || b; }
+    inline explicit operator uint32_t() const { return uint32_t{0xff000000} | (uint32_t{r} << 16) | (uint32_t{g} << 8) | uint32_t{b}; }
+    inline CRGB operator-() const { return {(uint8_t)(255 - r), (uint8_t)(255 - g), (uint8_t)(255 - b)}; }
+
+    inline uint8_t getLuma() const {
+        return ::scale8(r, 54) + ::scale8(g, 183) + ::scale8(b, 18);
+    }
+    inline uint8_t getAverageLight() const {
+        return ::scale8(r, 85) + ::scale8(g, 85) + ::scale8(b, 85);
+    }
+    inline void maximizeBrightness(uint8_t limit = 255) {
+        uint8_t mx = r;
+        if (g > mx) mx = g;
+        if (b > mx) mx = b;
+        if (mx == 0)
+            return;
+        const uint16_t factor = ((uint16_t)(limit) * 256) / mx;
+        r = (r * factor) / 256;
+        g = (g * factor) / 256;
+        b = (b * factor) / 256;
+    }
+    inline CRGB lerp8(const CRGB &other, fract8 frac) const {
+        return {lerp8by8(r, other.r, frac), lerp8by8(g, other.g, frac), lerp8by8(b, other.b, frac)};
+    }
+};
+
+inline bool operator==(const CRGB &lhs, const CRGB &rhs) { return (lhs.r == rhs.r) && (lhs.g == rhs.g) && (lhs.b == rhs.b); }
+inline bool operator!=(const CRGB &lhs, const CRGB &rhs) { return !(lhs == rhs); }
+inline bool operator<(const CRGB &lhs, const CRGB &rhs) { return (lhs.r + lhs.g + lhs.b) < (rhs.r + rhs.g + rhs.b); }
+inline bool operator>(const CRGB &lhs, const CRGB &rhs) { return (lhs.r + lhs.g + lhs.b) > (rhs.r + rhs.g + rhs.b); }
+inline bool operator<=(const CRGB &lhs, const CRGB &rhs) { return (lhs.r + lhs.g + lhs.b) <= (rhs.r + rhs.g + rhs.b); }
+inline bool operator>=(const CRGB &lhs, const CRGB &rhs) { return (lhs.r + lhs.g + lhs.b) >= (rhs.r + rhs.g + rhs.b); }
+inline CRGB operator+(const CRGB &p1, const CRGB &p2) { return {qadd8(p1.r, p2.r), qadd8(p1.g, p2.g), qadd8(p1.b, p2.b)}; }
+inline CRGB operator-(const CRGB &p1, const CRGB &p2) { return {qsub8(p1.r, p2.r), qsub8(p1.g, p2.g), qsub8(p1.b, p2.b)}; }
+inline CRGB operator*(const CRGB &p1, uint8_t d) { return {qmul8(p1.r, d), qmul8(p1.g, d), qmul8(p1.b, d)}; }
+inline CRGB operator/(const CRGB &p1, uint8_t d) { return {(uint8_t)(p1.r / d), (uint8_t)(p1.g / d), (uint8_t)(p1.b / d)}; }
+inline CRGB operator&(const CRGB &p1, const CRGB &p2) { return {min(p1.r, p2.r), min(p1.g, p2.g), min(p1.b, p2.b)}; }
+inline CRGB operator|(const CRGB &p1, const CRGB &p2) { return {max(p1.r, p2.r), max(p1.g, p2.g), max(p1.b, p2.b)}; }
+inline CRGB operator%(const CRGB &p1, uint8_t d) { CRGB retval(p1); retval.nscale8_video(d); return retval; }
+
+inline void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb) {
+    const uint8_t hue = hsv.hue;
+    const uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+    const uint8_t offset8 = (hue & 0x1F) << 3;
+    const uint8_t third = scale8(offset8, (256 / 3));
+    uint8_t r, g, b;
+    if (!(hue & 0x80)) {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) {
+                r = 255 - third; g = third; b = 0;
+            } else {
+                r = 171; g = 85 + third; b = 0;
+            }
+        } else {
+            if (!(hue & 0x20)) {
+                const uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+                r = 171 - twothirds; g = 170 + third; b = 0;
+            } else {
+                r = 0; g = 255 - third; b = third;
+            }
+        }
+    } else {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) {
+                const uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+                r = 0; g = 171 - twothirds; b = 85 + twothirds;
+            } else {
+                r = third; g = 0; b = 255 - third;
+            }
+        } else {
+            if (!(hue & 0x20)) {
+                r = 85 + third; g = 0; b = 171 - third;
+            } else {
+                r = 170 + third; g = 0; b = 85 - third;
+            }
+        }
+    }
+    if (sat != 255) {
+        if (sat == 0) {
+            r = 255; b = 255; g = 255;
+        } else {
+            uint8_t desat = 255 - sat;
+            desat = scale8_video(desat, desat);
+            const uint8_t satscale = 255 - desat;
+            r = scale8(r, satscale);
+            g = scale8(g, satscale);
+            b = scale8(b, satscale);
+            r += desat;
+            g += desat;
+            b += desat;
+        }
+    }
+    if (val != 255) {
+        val = scale8_video(val, val);
+        if (val == 0) {
+            r = 0; g = 0; b = 0;
+        } else {
+            r = scale8(r, val);
+            g = scale8(g, val);
+            b = scale8(b, val);
+        }
+    }
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+}
+inline void hsv2rgb_rainbow(const CHSV *phsv, CRGB *prgb, int numLeds) {
+    for (int i = 0; i < numLeds; ++i)
+        hsv2rgb_rainbow(phsv[i], prgb[i]);
+}
+
+inline CHSV rgb2hsv_approximate(const CRGB &rgb) {
+#define FIXFRAC8(N, D) (((N)*256)/(D))
+    uint8_t r = rgb.r;
+    uint8_t g = rgb.g;
+    uint8_t b = rgb.b;
+    uint8_t h, s, v;
+    uint8_t desat = 255;
+    if (r < desat) desat = r;
+    if (g < desat) desat = g;
+    if (b < desat) desat = b;
+    r -= desat;
+    g -= desat;
+    b -= desat;
+    s = 255 - desat;
+    if (s != 255)
+        s = 255 - sqrt16((255 - s) * 256);
+    if ((r + g + b) == 0)
+        return {0, 0, (uint8_t)(255 - s)};
+    if (s < 255) {
+        if (s == 0) s = 1;
+        const uint32_t scaleup = 65535 / (s);
+        r = ((uint32_t)(r) * scaleup) / 256;
+        g = ((uint32_t)(g) * scaleup) / 256;
+        b = ((uint32_t)(b) * scaleup) / 256;
+    }
+    uint16_t total = r + g + b;
+    if (total < 255) {
+        if (total == 0) total = 1;
+        const uint32_t scaleup = 65535 / (total);
+        r = ((uint32_t)(r) * scaleup) / 256;
+        g = ((uint32_t)(g) * scaleup) / 256;
+        b = ((uint32_t)(b) * scaleup) / 256;
+    }
+    if (total > 255)
+        v = 255;
+    else {
+        v = qadd8(desat, total);
+        if (v != 255)
+            v = sqrt16(v * 256);
+    }
+    uint8_t highest = r;
+    if (g > highest) highest = g;
+    if (b > highest) highest = b;
+    if (highest == r) {
+        if (g == 0) {
+            h = (HUE_PURPLE + HUE_PINK) / 2;
+            h += scale8(qsub8(r, 128), FIXFRAC8(48, 128));
+        } else if ((r - g) > g) {
+            h = HUE_RED;
+            h += scale8(g, FIXFRAC8(32, 85));
+        } else {
+            h = HUE_ORANGE;
+            h += scale8(qsub8((g - 85) + (171 - r), 4), FIXFRAC8(32, 85));
+        }
+    } else if (highest == g) {
+        if (b == 0) {
+            h = HUE_YELLOW;
+            const uint8_t radj = scale8(qsub8(171, r), 47);
+            const uint8_t gadj = scale8(qsub8(g, 171), 96);
+            const uint8_t rgadj = radj + gadj;
+            h += rgadj / 2;
+        } else {
+            if ((g - b) > b) {
+                h = HUE_GREEN;
+                h += scale8(b, FIXFRAC8(32, 85));
+            } else {
+                h = HUE_AQUA;
+                h += scale8(qsub8(b, 85), FIXFRAC8(8, 42));
+            }
+        }
+    } else {
+        if (r == 0) {
+            h = HUE_AQUA + ((HUE_BLUE - HUE_AQUA) / 4);
+            h += scale8(qsub8(b, 128), FIXFRAC8(24, 128));
+        } else if ((b - r) > r) {
+            h = HUE_BLUE;
+            h += scale8(r, FIXFRAC8(32, 85));
+        } else {
+            h = HUE_PURPLE;
+            h += scale8(qsub8(r, 85), FIXFRAC8(32, 85));
+        }
+    }
+    h += 1;
+    return {h, s, v};
+#undef FIXFRAC8
+}
+
+//~ color utilities ------------------------------
+inline void fill_solid(CRGB *leds, int numToFill, const CRGB &color) {
+    for (int i = 0; i < numToFill; ++i)
+        leds[i] = color;
+}
+inline void fill_rainbow(CRGB *leds, int numToFill, uint8_t initialhue, uint8_t deltahue = 5) {
+    CHSV hsv(initialhue, 240, 255);
+    for (int i = 0; i < numToFill; ++i) {
+        leds[i] = hsv;
+        hsv.hue += deltahue;
+    }
+}
+inline void fill_gradient_RGB(CRGB *leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor) {
+    if (endpos < startpos) {
+        const uint16_t t = endpos;
+        const CRGB tc = endcolor;
+        endcolor = startcolor;
+        endpos = startpos;
+        startpos = t;
+        startcolor = tc;
+    }
+    saccum87 rdistance87 = (endcolor.r - startcolor.r) << 7;
+    saccum87 gdistance87 = (endcolor.g - startcolor.g) << 7;
+    saccum87 bdistance87 = (endcolor.b - startcolor.b) << 7;
+    const uint16_t pixeldistance = endpos - startpos;
+    const int16_t divisor = pixeldistance ? pixeldistance : 1;
+    saccum87 rdelta87 = rdistance87 / divisor;
+    saccum87 gdelta87 = gdistance87 / divisor;
+    saccum87 bdelta87 = bdistance87 / divisor;
+    rdelta87 *= 2;
+    gdelta87 *= 2;
+    bdelta87 *= 2;
+    accum88 r88 = startcolor.r << 8;
+    accum88 g88 = startcolor.g << 8;
+    accum88 b88 = startcolor.b << 8;
+    for (uint16_t i = startpos; i <= endpos; ++i) {
+        leds[i] = CRGB(r88 >> 8, g88 >> 8, b88 >> 8);
+        r88 += rdelta87;
+        g88 += gdelta87;
+        b88 += bdelta87;
+    }
+}
+inline void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2) {
+    fill_gradient_RGB(leds, 0, c1, numLeds - 1, c2);
+}
+inline void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3) {
+    const uint16_t half = (numLeds / 2);
+    fill_gradient_RGB(leds, 0, c1, half, c2);
+    fill_gradient_RGB(leds, half, c2, numLeds - 1, c3);
+}
+inline void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4) {
+    const uint16_t onethird = (numLeds / 3);
+    const uint16_t twothirds = ((numLeds * 2) / 3);
+    fill_gradient_RGB(leds, 0, c1, onethird, c2);
+    fill_gradient_RGB(leds, onethird, c2, twothirds, c3);
+    fill_gradient_RGB(leds, twothirds, c3, numLeds - 1, c4);
+}
+inline CRGB HeatColor(uint8_t temperature) {
+    CRGB heatcolor;
+    const uint8_t t192 = scale8_video(temperature, 191);
+    const uint8_t heatramp = (t192 & 0x3F) << 2;
+    if (t192 & 0x80)
+        heatcolor = CRGB(255, 255, heatramp);
+    else if (t192 & 0x40)
+        heatcolor = CRGB(255, heatramp, 0);
+    else
+        heatcolor = CRGB(heatramp, 0, 0);
+    return heatcolor;
+}
+inline void nscale8_video(CRGB *leds, uint16_t numLeds, uint8_t scale) {
+    for (uint16_t i = 0; i < numLeds; ++i)
+        leds[i].nscale8_video(scale);
+}
+inline void fadeLightBy(CRGB *leds, uint16_t numLeds, uint8_t fadeBy) { nscale8_video(leds, numLeds, 255 - fadeBy); }
+inline void nscale8(CRGB *leds, uint16_t numLeds, uint8_t scale) {
+    for (uint16_t i = 0; i < numLeds; ++i)
+        leds[i].nscale8(scale);
+}
+inline void fadeToBlackBy(CRGB *leds, uint16_t numLeds, uint8_t fadeBy) { nscale8(leds, numLeds, 255 - fadeBy); }
+inline void fade_raw(CRGB *leds, uint16_t numLeds, uint8_t fadeBy) { nscale8(leds, numLeds, 255 - fadeBy); }
+inline CRGB &nblend(CRGB &existing, const CRGB &overlay, fract8 amountOfOverlay) {
+    if (amountOfOverlay == 0)
+        return existing;
+    if (amountOfOverlay == 255) {
+        existing = overlay;
+        return existing;
+    }
+    existing.red = blend8(existing.red, overlay.red, amountOfOverlay);
+    existing.green = blend8(existing.green, overlay.green, amountOfOverlay);
+    existing.blue = blend8(existing.blue, overlay.blue, amountOfOverlay);
+    return existing;
+}
+inline void nblend(CRGB *existing, const CRGB *overlay, uint16_t count, fract8 amountOfOverlay) {
+    for (uint16_t i = count; i; --i) {
+        nblend(*existing, *overlay, amountOfOverlay);
+        ++existing;
+        ++overlay;
+    }
+}
+inline CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2) {
+    CRGB nu(p1);
+    nblend(nu, p2, amountOfP2);
+    return nu;
+}
+inline CRGB *blend(const CRGB *src1, const CRGB *src2, CRGB *dest, uint16_t count, fract8 amountOfSrc2) {
+    for (uint16_t i = 0; i < count; ++i)
+        dest[i] = blend(src1[i], src2[i], amountOfSrc2);
+    return dest;
+}
+inline void blur1d(CRGB *leds, uint16_t numLeds, fract8 blurAmount) {
+    const uint8_t keep = 255 - blurAmount;
+    const uint8_t seep = blurAmount >> 1;
+    CRGB carryover = CRGB::Black;
+    for (uint16_t i = 0; i < numLeds; ++i) {
+        CRGB cur = leds[i];
+        CRGB part = cur;
+        part.nscale8(seep);
+        cur.nscale8(keep);
+        cur += carryover;
+        if (i)
+            leds[i - 1] += part;
+        leds[i] = cur;
+        carryover = part;
+    }
+}
+
+//~ palettes ------------------------------
+typedef uint32_t TProgmemRGBPalette16[16];
+typedef uint32_t TProgmemHSVPalette16[16];
+typedef TProgmemRGBPalette16 TProgmemPalette16;
+typedef const uint8_t TProgmemRGBGradientPalette_byte;
+typedef TProgmemRGBGradientPalette_byte *TProgmemRGBGradientPalette_bytes;
+typedef enum { NOBLEND = 0, LINEARBLEND = 1, LINEARBLEND_NOWRAP = 2 } TBlendType;
+
+class CHSVPalette16 {
+public:
+    CHSV entries[16];
+
+    CHSVPalette16() = default;
+    inline CHSV &operator[](uint8_t x) { return entries[x]; }
+    inline const CHSV &operator[](uint8_t x) const { return entries[x]; }
+};
+
+class CRGBPalette16 {
+public:
+    CRGB entries[16];
+
+    CRGBPalette16() = default;
+    CRGBPalette16(const CRGB &c00, const CRGB &c01, const CRGB &c02, const CRGB &c03, const CRGB &c04, const CRGB &c05, const CRGB &c06,
+                  const CRGB &c07, const CRGB &c08, const CRGB &c09, const CRGB &c10, const CRGB &c11, const CRGB &c12, const CRGB &c13,
+                  const CRGB &c14, const CRGB &c15) : entries{c00, c01, c02, c03, c04, c05, c06, c07, c08, c09, c10, c11, c12, c13, c14, c15} {}
+    CRGBPalette16(const CRGBPalette16 &rhs) = default;
+    CRGBPalette16 &operator=(const CRGBPalette16 &rhs) = default;
+    CRGBPalette16(const CRGB rhs[16]) { memmove(entries, rhs, sizeof(entries)); }
+    CRGBPalette16(const TProgmemRGBPalette16 &rhs) {
+        for (uint8_t i = 0; i < 16; ++i)
+            entries[i] = rhs[i];
+    }
+    CRGBPalette16 &operator=(const TProgmemRGBPalette16 &rhs) {
+        for (uint8_t i = 0; i < 16; ++i)
+            entries[i] = rhs[i];
+        return *this;
+    }
+    CRGBPalette16(const CHSVPalette16 &rhs) {
+        for (uint8_t i = 0; i < 16; ++i)
+            entries[i] = rhs.entries[i];
+    }
+    CRGBPalette16(const CHSV &c1) { fill_solid(entries, 16, CRGB(c1)); }
+    CRGBPalette16(const CRGB &c1) { fill_solid(entries, 16, c1); }
+    CRGBPalette16(const CRGB &c1, const CRGB &c2) { fill_gradient_RGB(entries, 16, c1, c2); }
+    CRGBPalette16(const CRGB &c1, const CRGB &c2, const CRGB &c3) { fill_gradient_RGB(entries, 16, c1, c2, c3); }
+    CRGBPalette16(const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4) { fill_gradient_RGB(entries, 16, c1, c2, c3, c4); }
+    CRGBPalette16(TProgmemRGBGradientPalette_bytes progpal) { *this = progpal; }
+    CRGBPalette16 &operator=(TProgmemRGBGradientPalette_bytes progpal) {
+        //gradient palette - entries of {index, r, g, b}, last index is 255
+        const uint8_t *progent = progpal;
+        uint8_t istart8 = 0;
+        CRGB rgbstart(progent[1], progent[2], progent[3]);
+        int indexstart = 0;
+        do {
+            progent += 4;
+            const int indexend = progent[0];
+            const CRGB rgbend(progent[1], progent[2], progent[3]);
+            const uint8_t iend8 = indexend / 16;
+            if (istart8 <= iend8 && iend8 < 16)
+                fill_gradient_RGB(entries, istart8, rgbstart, iend8, rgbend);
+            indexstart = indexend;
+            istart8 = iend8 + 1;
+            rgbstart = rgbend;
+        } while (indexstart < 255);
+        return *this;
+    }
+    bool operator==(const CRGBPalette16 &rhs) const { return memcmp(entries, rhs.entries, sizeof(entries)) == 0; }
+    bool operator!=(const CRGBPalette16 &rhs) const { return !(*this == rhs); }
+    inline CRGB &operator[](uint8_t x) { return entries[x]; }
+    inline const CRGB &operator[](uint8_t x) const { return entries[x]; }
+    operator CRGB *() { return &(entries[0]); }
+    operator const CRGB *() const { return &(entries[0]); }
+};
+
+inline CRGB ColorFromPalette(const CRGBPalette16 &pal, uint8_t index, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND) {
+    if (blendType == LINEARBLEND_NOWRAP)
+        index = map8(index, 0, 239);
+    const uint8_t hi4 = lsrX4(index);
+    const uint8_t lo4 = index & 0x0F;
+    const CRGB *entry = &(pal[0]) + hi4;
+    uint8_t red1 = entry->red;
+    uint8_t green1 = entry->green;
+    uint8_t blue1 = entry->blue;
+    if (lo4 && (blendType != NOBLEND)) {
+        if (hi4 == 15)
+            entry = &(pal[0]);
+        else
+            ++entry;
+        const uint8_t f2 = lo4 << 4;
+        const uint8_t f1 = 255 - f2;
+        red1 = scale8(red1, f1) + scale8(entry->red, f2);
+        green1 = scale8(green1, f1) + scale8(entry->green, f2);
+        blue1 = scale8(blue1, f1) + scale8(entry->blue, f2);
+    }
+    if (brightness != 255) {
+        if (brightness) {
+            ++brightness;   //adjust for rounding
+            if (red1)
+                red1 = scale8(red1, brightness);
+            if (green1)
+                green1 = scale8(green1, brightness);
+            if (blue1)
+                blue1 = scale8(blue1, brightness);
+        } else {
+            red1 = green1 = blue1 = 0;
+        }
+    }
+    return {red1, green1, blue1};
+}
+
+inline void nblendPaletteTowardPalette(CRGBPalette16 &current, CRGBPalette16 &target, uint8_t maxChanges) {
+    uint8_t *p1 = (uint8_t *)current.entries;
+    uint8_t *p2 = (uint8_t *)target.entries;
+    uint8_t changes = 0;
+    for (uint8_t i = 0; i < sizeof(CRGBPalette16); ++i) {
+        if (p1[i] == p2[i])
+            continue;
+        if (p1[i] < p2[i]) {
+            ++p1[i];
+            ++changes;
+        }
+        if (p1[i] > p2[i]) {
+            --p1[i];
+            ++changes;
+            if (p1[i] > p2[i])
+                --p1[i];
+        }
+        if (changes >= maxChanges)
+            break;
+    }
+}
+
+inline const TProgmemRGBPalette16 CloudColors_p = {
+    CRGB::Blue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+    CRGB::Blue, CRGB::DarkBlue, CRGB::SkyBlue, CRGB::SkyBlue, CRGB::LightBlue, CRGB::White, CRGB::LightBlue, CRGB::SkyBlue};
+inline const TProgmemRGBPalette16 LavaColors_p = {
+    CRGB::Black, CRGB::Maroon, CRGB::Black, CRGB::Maroon, CRGB::DarkRed, CRGB::DarkRed, CRGB::Maroon, CRGB::DarkRed,
+    CRGB::DarkRed, CRGB::DarkRed, CRGB::Red, CRGB::Orange, CRGB::White, CRGB::Orange, CRGB::Red, CRGB::DarkRed};
+inline const TProgmemRGBPalette16 OceanColors_p = {
+    CRGB::MidnightBlue, CRGB::DarkBlue, CRGB::MidnightBlue, CRGB::Navy, CRGB::DarkBlue, CRGB::MediumBlue, CRGB::SeaGreen, CRGB::Teal,
+    CRGB::CadetBlue, CRGB::Blue, CRGB::DarkCyan, CRGB::CornflowerBlue, CRGB::Aquamarine, CRGB::SeaGreen, CRGB::Aqua, CRGB::LightSkyBlue};
+inline const TProgmemRGBPalette16 ForestColors_p = {
+    CRGB::DarkGreen, CRGB::DarkGreen, CRGB::DarkOliveGreen, CRGB::DarkGreen, CRGB::Green, CRGB::ForestGreen, CRGB::OliveDrab, CRGB::Green,
+    CRGB::SeaGreen, CRGB::MediumAquamarine, CRGB::LimeGreen, CRGB::YellowGreen, CRGB::LightGreen, CRGB::LawnGreen, CRGB::MediumAquamarine,
+    CRGB::ForestGreen};
+inline const TProgmemRGBPalette16 RainbowColors_p = {
+    0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+    0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B};
+inline const TProgmemRGBPalette16 RainbowStripeColors_p = {
+    0xFF0000, 0x000000, 0xAB5500, 0x000000, 0xABAB00, 0x000000, 0x00FF00, 0x000000,
+    0x00AB55, 0x000000, 0x0000FF, 0x000000, 0x5500AB, 0x000000, 0xAB0055, 0x000000};
+inline const TProgmemRGBPalette16 PartyColors_p = {
+    0x5500AB, 0x84007C, 0xB5004B, 0xE5001B, 0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+    0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E, 0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9};
+inline const TProgmemRGBPalette16 HeatColors_p = {
+    0x000000, 0x330000, 0x660000, 0x990000, 0xCC0000, 0xFF0000, 0xFF3300, 0xFF6600,
+    0xFF9900, 0xFFCC00, 0xFFFF00, 0xFFFF33, 0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF};
+
+inline const uint8_t Rainbow_gp[] = {
+    0, 255, 0, 0, 32, 171, 85, 0, 64, 171, 171, 0, 96, 0, 255, 0, 128, 0, 171, 85, 160, 0, 0, 255, 192, 85, 0, 171, 224, 171, 0, 85,
+    255, 255, 0, 0};
+
+//~ pixel sets ------------------------------
+/**
+ * View of a range of pixels - FastLED's CPixelView: a negative length is a reversed range, the view's pixel 0 being the last one of the range
+ */
+template<class PIXEL_TYPE> class CPixelView {
+public:
+    const int8_t dir;
+    const int len;
+    PIXEL_TYPE *const leds;
+    PIXEL_TYPE *const end_pos;
+
+    template<class T> class pixelset_iterator_base {
+        T *leds;
+        const int8_t dir;
+    public:
+        pixelset_iterator_base(const pixelset_iterator_base &rhs) : leds(rhs.leds), dir(rhs.dir) {}
+        pixelset_iterator_base(T *_leds, const int8_t _dir) : leds(_leds), dir(_dir) {}
+        pixelset_iterator_base &operator++() { leds += dir; return *this; }
+        pixelset_iterator_base operator++(int) { pixelset_iterator_base tmp(*this); leds += dir; return tmp; }
+        bool operator==(const pixelset_iterator_base &other) const { return leds == other.leds; }
+        bool operator!=(const pixelset_iterator_base &other) const { return leds != other.leds; }
+        PIXEL_TYPE &operator*() const { return *leds; }
+    };
+    typedef pixelset_iterator_base<PIXEL_TYPE> iterator;
+    typedef pixelset_iterator_base<const PIXEL_TYPE> const_iterator;
+
+    CPixelView(const CPixelView &other) : dir(other.dir), len(other.len), leds(other.leds), end_pos(other.end_pos) {}
+    CPixelView(PIXEL_TYPE *_leds, int _len) : dir(_len < 0 ? -1 : 1), len(_len), leds(_leds), end_pos(_leds + _len) {}
+    CPixelView(PIXEL_TYPE *_leds, int _start, int _end) : dir(((_end - _start) < 0) ? -1 : 1), len((_end - _start) + dir), leds(_leds + _start),
+            end_pos(_leds + _start + len) {}
+
+    int size() const { return abs(len); }
+    bool reversed() const { return len < 0; }
+    bool operator==(const CPixelView &rhs) const { return leds == rhs.leds && len == rhs.len && dir == rhs.dir; }
+    bool operator!=(const CPixelView &rhs) const { return leds != rhs.leds || len != rhs.len || dir != rhs.dir; }
+    PIXEL_TYPE &operator[](int x) const { return (dir & 0x80) ? leds[-x] : leds[x]; }
+    CPixelView operator()(int start, int end) { return CPixelView(leds, start, end); }
+    CPixelView operator-() { return CPixelView(leds, len - dir, 0); }
+    operator PIXEL_TYPE *() const { return leds; }
+
+    CPixelView &operator=(const PIXEL_TYPE &color) {
+        for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel)
+            (*pixel) = color;
+        return *this;
+    }
+    CPixelView &operator=(const CPixelView &rhs) {
+        for (iterator pixel = begin(), rhspixel = rhs.begin(), _end = end(), rhs_end = rhs.end(); (pixel != _end) && (rhspixel != rhs_end);
+             ++pixel, ++rhspixel)
+            (*pixel) = (*rhspixel);
+        return *this;
+    }
+    CPixelView &addToRGB(uint8_t inc) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) += inc; return *this; }
+    CPixelView &operator+=(const CPixelView &rhs) {
+        for (iterator pixel = begin(), rhspixel = rhs.begin(), _end = end(), rhs_end = rhs.end(); (pixel != _end) && (rhspixel != rhs_end);
+             ++pixel, ++rhspixel)
+            (*pixel) += (*rhspixel);
+        return *this;
+    }
+    CPixelView &operator+=(const PIXEL_TYPE &color) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) += color; return *this; }
+    CPixelView &subFromRGB(uint8_t inc) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) -= inc; return *this; }
+    CPixelView &operator-=(const CPixelView &rhs) {
+        for (iterator pixel = begin(), rhspixel = rhs.begin(), _end = end(), rhs_end = rhs.end(); (pixel != _end) && (rhspixel != rhs_end);
+             ++pixel, ++rhspixel)
+            (*pixel) -= (*rhspixel);
+        return *this;
+    }
+    CPixelView &operator/=(uint8_t d) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) /= d; return *this; }
+    CPixelView &operator>>=(uint8_t d) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) >>= d; return *this; }
+    CPixelView &operator*=(uint8_t d) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) *= d; return *this; }
+    CPixelView &nscale8_video(uint8_t scaledown) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel).nscale8_video(scaledown); return *this; }
+    CPixelView &operator%=(uint8_t scaledown) { return nscale8_video(scaledown); }
+    CPixelView &fadeLightBy(uint8_t fadefactor) { return nscale8_video(255 - fadefactor); }
+    CPixelView &nscale8(uint8_t scaledown) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel).nscale8(scaledown); return *this; }
+    CPixelView &nscale8(PIXEL_TYPE &scaledown) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel).nscale8(scaledown); return *this; }
+    CPixelView &fadeToBlackBy(uint8_t fade) { return nscale8(255 - fade); }
+    CPixelView &operator|=(const PIXEL_TYPE &rhs) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) |= rhs; return *this; }
+    CPixelView &operator&=(const PIXEL_TYPE &rhs) { for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) (*pixel) &= rhs; return *this; }
+    explicit operator bool() const { for (const_iterator pixel = begin(), _end = end(); pixel != _end; ++pixel) { if (*pixel) return true; } return false; }
+
+    CPixelView &fill_solid(const PIXEL_TYPE &color) { *this = color; return *this; }
+    CPixelView &fill_rainbow(uint8_t initialhue, uint8_t deltahue = 5) {
+        if (dir >= 0)
+            ::fill_rainbow(leds, len, initialhue, deltahue);
+        else
+            ::fill_rainbow(leds + len + 1, -len, initialhue - deltahue * (len + 1), -deltahue);
+        return *this;
+    }
+    CPixelView &fill_gradient_RGB(const CRGB &c1, const CRGB &c2) {
+        if (dir >= 0)
+            ::fill_gradient_RGB(leds, len, c1, c2);
+        else
+            ::fill_gradient_RGB(leds + len + 1, (-len), c2, c1);
+        return *this;
+    }
+    CPixelView &fill_gradient_RGB(const CRGB &c1, const CRGB &c2, const CRGB &c3) {
+        if (dir >= 0)
+            ::fill_gradient_RGB(leds, len, c1, c2, c3);
+        else
+            ::fill_gradient_RGB(leds + len + 1, (-len), c3, c2, c1);
+        return *this;
+    }
+    CPixelView &fill_gradient_RGB(const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4) {
+        if (dir >= 0)
+            ::fill_gradient_RGB(leds, len, c1, c2, c3, c4);
+        else
+            ::fill_gradient_RGB(leds + len + 1, (-len), c4, c3, c2, c1);
+        return *this;
+    }
+    CPixelView &nblend(const PIXEL_TYPE &overlay, fract8 amountOfOverlay) {
+        for (iterator pixel = begin(), _end = end(); pixel != _end; ++pixel)
+            ::nblend((*pixel), overlay, amountOfOverlay);
+        return *this;
+    }
+    CPixelView &nblend(const CPixelView &rhs, fract8 amountOfOverlay) {
+        for (iterator pixel = begin(), rhspixel = rhs.begin(), _end = end(), rhs_end = rhs.end(); (pixel != _end) && (rhspixel != rhs_end);
+             ++pixel, ++rhspixel)
+            ::nblend((*pixel), (*rhspixel), amountOfOverlay);
+        return *this;
+    }
+    CPixelView &blur1d(fract8 blurAmount) {
+        if (dir >= 0)
+            ::blur1d(leds, len, blurAmount);
+        return *this;
+    }
+
+    iterator begin() { return iterator(leds, dir); }
+    iterator end() { return iterator(end_pos, dir); }
+    iterator begin() const { return iterator(leds, dir); }
+    iterator end() const { return iterator(end_pos, dir); }
+    const_iterator cbegin() const { return const_iterator(leds, dir); }
+    const_iterator cend() const { return const_iterator(end_pos, dir); }
+};
+
+typedef CPixelView<CRGB> CRGBSet;
+
+template<int SIZE> class CRGBArray : public CPixelView<CRGB> {
+    CRGB rawleds[SIZE];
+public:
+    CRGBArray() : CPixelView<CRGB>(rawleds, SIZE) {}
+    using CPixelView::operator=;
+};
+
+//~ controllers ------------------------------
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+enum EDitherMode { DISABLE_DITHER = 0x00, BINARY_DITHER = 0x01 };
+
+/**
+ * Pixel data of a frame being shown, scaled by the brightness and color adjustment - FastLED's PixelController without temporal dithering
+ */
+template<EOrder RGB_ORDER, int LANES = 1, uint32_t MASK = 0xFFFFFFFF> struct PixelController {
+    const uint8_t *mData;
+    int mLen;
+    int mLenRemaining;
+    int8_t mAdvance;
+    CRGB mScale;
+
+    PixelController(const CRGB *d, int len, CRGB &s, EDitherMode) : mData((const uint8_t *)d), mLen(len), mLenRemaining(len), mAdvance(3), mScale(s) {}
+    PixelController(const CRGB &d, int len, CRGB &s, EDitherMode) : mData((const uint8_t *)&d), mLen(len), mLenRemaining(len), mAdvance(0), mScale(s) {}
+
+    static constexpr uint8_t ro(uint8_t x) { return (RGB_ORDER >> (3 * (2 - x))) & 0x3; }
+    bool has(int n) const { return mLenRemaining >= n; }
+    int size() const { return mLen; }
+    void advanceData() { mData += mAdvance; mLenRemaining--; }
+    void stepDithering() {}
+    void preStepFirstByteDithering() {}
+    uint8_t loadAndScale0() const { return scale8(mData[ro(0)], mScale.raw[ro(0)]); }
+    uint8_t loadAndScale1() const { return scale8(mData[ro(1)], mScale.raw[ro(1)]); }
+    uint8_t loadAndScale2() const { return scale8(mData[ro(2)], mScale.raw[ro(2)]); }
+};
+
+class CLEDController {
+protected:
+    friend class CFastLED;
+    CRGB *m_Data = nullptr;
+    CLEDController *m_pNext = nullptr;
+    CRGB m_ColorCorrection = UncorrectedColor;
+    CRGB m_ColorTemperature = UncorrectedTemperature;
+    EDitherMode m_DitherMode = BINARY_DITHER;
+    int m_nLeds = 0;
+    static inline CLEDController *m_pHead = nullptr;
+    static inline CLEDController *m_pTail = nullptr;
+
+    virtual void showColor(const CRGB &data, int nLeds, CRGB scale) = 0;
+    virtual void show(const CRGB *data, int nLeds, CRGB scale) = 0;
+public:
+    CLEDController() {
+        if (m_pHead == nullptr)
+            m_pHead = this;
+        if (m_pTail != nullptr)
+            m_pTail->m_pNext = this;
+        m_pTail = this;
+    }
+    virtual ~CLEDController() = default;
+    virtual void init() = 0;
+    virtual void clearLeds(int nLeds) { showColor(CRGB::Black, nLeds, CRGB::Black); }
+    void showLeds(uint8_t brightness = 255) { show(m_Data, m_nLeds, getAdjustment(brightness)); }
+    void showColor(const CRGB &data, uint8_t brightness = 255) { showColor(data, m_nLeds, getAdjustment(brightness)); }
+    static CLEDController *head() { return m_pHead; }
+    CLEDController *next() { return m_pNext; }
+    CLEDController &setLeds(CRGB *data, int nLeds) { m_Data = data; m_nLeds = nLeds; return *this; }
+    void clearLedData() { if (m_Data) memset(m_Data, 0, sizeof(CRGB) * m_nLeds); }
+    int size() const { return m_nLeds; }
+    CRGB *leds() { return m_Data; }
+    CLEDController &setDither(uint8_t ditherMode = BINARY_DITHER) { m_DitherMode = (EDitherMode)ditherMode; return *this; }
+    uint8_t getDither() const { return m_DitherMode; }
+    CLEDController &setCorrection(CRGB correction) { m_ColorCorrection = correction; return *this; }
+    CLEDController &setCorrection(LEDColorCorrection correction) { m_ColorCorrection = correction; return *this; }
+    CRGB getCorrection() const { return m_ColorCorrection; }
+    CLEDController &setTemperature(CRGB temperature) { m_ColorTemperature = temperature; return *this; }
+    CLEDController &setTemperature(ColorTemperature temperature) { m_ColorTemperature = temperature; return *this; }
+    CRGB getTemperature() const { return m_ColorTemperature; }
+    CRGB getAdjustment(uint8_t scale) const { return computeAdjustment(scale, m_ColorCorrection, m_ColorTemperature); }
+    static CRGB computeAdjustment(uint8_t scale, const CRGB &colorCorrection, const CRGB &colorTemperature) {
+        CRGB adj(0, 0, 0);
+        if (scale > 0) {
+            for (uint8_t i = 0; i < 3; ++i) {
+                const uint8_t cc = colorCorrection.raw[i];
+                const uint8_t ct = colorTemperature.raw[i];
+                if (cc > 0 && ct > 0) {
+                    uint32_t work = (((uint32_t)cc) + 1) * (((uint32_t)ct) + 1) * scale;
+                    work /= 0x10000L;
+                    adj.raw[i] = work & 0xFF;
+                }
+            }
+        }
+        return adj;
+    }
+};
+
+template<EOrder RGB_ORDER, int LANES = 1, uint32_t MASK = 0xFFFFFFFF> class CPixelLEDController : public CLEDController {
+protected:
+    virtual void showPixels(PixelController<RGB_ORDER, LANES, MASK> &pixels) = 0;
+    void showColor(const CRGB &data, int nLeds, CRGB scale) override {
+        PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, scale, (EDitherMode)getDither());
+        showPixels(pixels);
+    }
+    void show(const CRGB *data, int nLeds, CRGB scale) override {
+        PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds < 0 ? -nLeds : nLeds, scale, (EDitherMode)getDither());
+        if (nLeds < 0)
+            pixels.mAdvance = -pixels.mAdvance;
+        showPixels(pixels);
+    }
+};
+
+/**
+ * Clockless chipset controller - on the host the pixels go nowhere
+ */
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class WS2811 : public CPixelLEDController<RGB_ORDER> {
+protected:
+    void init() override {}
+    void showPixels(PixelController<RGB_ORDER> &) override {}
+};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class WS2812 : public WS2811<DATA_PIN, RGB_ORDER> {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = RGB> class WS2812B : public WS2811<DATA_PIN, RGB_ORDER> {};
+
+class CFastLED {
+    uint8_t m_Scale = 255;
+public:
+    static CLEDController &addLeds(CLEDController *pLed, CRGB *data, int nLedsOrOffset, int nLedsIfOffset = 0) {
+        const int nOffset = (nLedsIfOffset > 0) ? nLedsOrOffset : 0;
+        const int nLeds = (nLedsIfOffset > 0) ? nLedsIfOffset : nLedsOrOffset;
+        pLed->init();
+        pLed->setLeds(data + nOffset, nLeds);
+        return *pLed;
+    }
+    template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+    static CLEDController &addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset = 0) {
+        static CHIPSET<DATA_PIN, RGB_ORDER> c;
+        return addLeds(&c, data, nLedsOrOffset, nLedsIfOffset);
+    }
+    void setBrightness(uint8_t scale) { m_Scale = scale; }
+    uint8_t getBrightness() const { return m_Scale; }
+    void show(uint8_t scale) {
+        for (CLEDController *pCur = CLEDController::head(); pCur != nullptr; pCur = pCur->next())
+            pCur->showLeds(scale);
+    }
+    void show() { show(m_Scale); }
+    void clear(bool writeData = false) {
+        if (writeData)
+            showColor(CRGB::Black, 0);
+        for (CLEDController *pCur = CLEDController::head(); pCur != nullptr; pCur = pCur->next())
+            pCur->clearLedData();
+    }
+    void showColor(const CRGB &color, uint8_t scale) {
+        for (CLEDController *pCur = CLEDController::head(); pCur != nullptr; pCur = pCur->next())
+            pCur->showColor(color, scale);
+    }
+    void showColor(const CRGB &color) { showColor(color, m_Scale); }
+    void delay(unsigned long ms) {
+        show();
+        ::delay(ms);
+    }
+    void setTemperature(const CRGB &temp) {
+        for (CLEDController *pCur = CLEDController::head(); pCur != nullptr; pCur = pCur->next())
+            pCur->setTemperature(temp);
+    }
+    void setCorrection(const CRGB &correction) {
+        for (CLEDController *pCur = CLEDController::head(); pCur != nullptr; pCur = pCur->next())
+            pCur->setCorrection(correction);
+    }
+    void setDither(uint8_t ditherMode = BINARY_DITHER) {
+        for (CLEDController *pCur = CLEDController::head(); pCur != nullptr; pCur = pCur->next())
+            pCur->setDither(ditherMode);
+    }
+    int count() const {
+        int x = 0;
+        for (CLEDController *pCur = CLEDController::head(); pCur != nullptr; pCur = pCur->next())
+            ++x;
+        return x;
+    }
+    CLEDController &operator[](int x) {
+        CLEDController *pCur = CLEDController::head();
+        while (x-- && pCur)
+            pCur = pCur->next();
+        return *pCur;
+    }
+};
+
+inline CFastLED FastLED;
+
+#endif //TEEN_LIGHTFX_SHIM_FASTLED_H
@@ -0,0 +1,28 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the LittleFS wrapper - the files live in a host directory; it is not created, such that native runs start
+// from a clean state (no file found) unless the directory is set up beforehand
+
+#ifndef TEEN_LIGHTFX_SHIM_LITTLEFSWRAPPER_H
+#define TEEN_LIGHTFX_SHIM_LITTLEFSWRAPPER_H
+
+#include <Arduino.h>
+#include <dirent.h>
+
+#define LITTLEFS_NAME           "lfs"
+#define LITTLEFS_FILE_PREFIX    "./.pio/" LITTLEFS_NAME
+#define LITTLEFS_ROOT_PATH      LITTLEFS_FILE_PREFIX "/"
+
+struct HostFileSystem {
+    int remove(const char *fname) { return ::remove(fname); }
+};
+static HostFileSystem lfs;
+
+class LittleFSWrapper {
+public:
+    bool init() { return true; }
+    bool unmount() { return true; }
+    static const char *getRoot() { return LITTLEFS_ROOT_PATH; }
+};
+
+#endif //TEEN_LIGHTFX_SHIM_LITTLEFSWRAPPER_H
@@ -0,0 +1,9 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_SHIM_MUTEX_H
+#define TEEN_LIGHTFX_SHIM_MUTEX_H
+
+#include <mbed.h>
+
+#endif //TEEN_LIGHTFX_SHIM_MUTEX_H
@@ -0,0 +1,25 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the NTP client - time is never synchronized
+
+#ifndef TEEN_LIGHTFX_SHIM_NTPCLIENT_H
+#define TEEN_LIGHTFX_SHIM_NTPCLIENT_H
+
+#include <Arduino.h>
+#include <WiFiNINA.h>
+
+class NTPClient {
+    long timeOffset;
+public:
+    NTPClient(UDP &, long offset = 0) : timeOffset(offset) {}
+    void begin() {}
+    bool update() { return false; }
+    bool forceUpdate() { return false; }
+    void end() {}
+    bool isTimeSet() const { return false; }
+    void setTimeOffset(int offset) { timeOffset = offset; }
+    unsigned long getEpochTime() const { return timeOffset + millis() / 1000; }
+    String getFormattedTime() const { return String("00:00:00"); }
+};
+
+#endif //TEEN_LIGHTFX_SHIM_NTPCLIENT_H
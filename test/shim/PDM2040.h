@@ -0,0 +1,10 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the PDM microphone driver - the audio unit (mic.cpp) is not part of the native builds
+
+#ifndef TEEN_LIGHTFX_SHIM_PDM2040_H
+#define TEEN_LIGHTFX_SHIM_PDM2040_H
+
+#include <Arduino.h>
+
+#endif //TEEN_LIGHTFX_SHIM_PDM2040_H
@@ -0,0 +1,110 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the Time library - same API and calendar math, the clock starts at the epoch (as on the board before a
+// time sync) unless set
+
+#ifndef TEEN_LIGHTFX_SHIM_TIMELIB_H
+#define TEEN_LIGHTFX_SHIM_TIMELIB_H
+
+#include <Arduino.h>
+#include <ctime>
+
+typedef enum { timeNotSet, timeNeedsSync, timeSet } timeStatus_t;
+typedef enum { dowInvalid, dowSunday, dowMonday, dowTuesday, dowWednesday, dowThursday, dowFriday, dowSaturday } timeDayOfWeek_t;
+
+typedef struct {
+    uint8_t Second;
+    uint8_t Minute;
+    uint8_t Hour;
+    uint8_t Wday;   //day of week, sunday is day 1
+    uint8_t Day;
+    uint8_t Month;
+    uint8_t Year;   //offset from 1970
+} tmElements_t;
+
+#define SECS_PER_MIN  ((time_t)(60UL))
+#define SECS_PER_HOUR ((time_t)(3600UL))
+#define SECS_PER_DAY  ((time_t)(SECS_PER_HOUR * 24UL))
+#define DAYS_PER_WEEK ((time_t)(7UL))
+#define SECS_PER_WEEK ((time_t)(SECS_PER_DAY * DAYS_PER_WEEK))
+#define SECS_PER_YEAR ((time_t)(SECS_PER_DAY * 365UL))
+#define tmYearToCalendar(Y) ((Y) + 1970)
+#define CalendarYrToTm(Y)   ((Y) - 1970)
+#define numberOfSeconds(_time_) ((_time_) % SECS_PER_MIN)
+#define numberOfMinutes(_time_) (((_time_) / SECS_PER_MIN) % SECS_PER_MIN)
+#define numberOfHours(_time_) (((_time_) % SECS_PER_DAY) / SECS_PER_HOUR)
+#define dayOfWeek(_time_) ((((_time_) / SECS_PER_DAY + 4) % DAYS_PER_WEEK) + 1)
+#define elapsedDays(_time_) ((_time_) / SECS_PER_DAY)
+#define elapsedSecsToday(_time_) ((_time_) % SECS_PER_DAY)
+#define previousMidnight(_time_) (((_time_) / SECS_PER_DAY) * SECS_PER_DAY)
+#define nextMidnight(_time_) (previousMidnight(_time_) + SECS_PER_DAY)
+#define elapsedSecsThisWeek(_time_) (elapsedSecsToday(_time_) + ((dayOfWeek(_time_) - 1) * SECS_PER_DAY))
+#define previousSunday(_time_) ((_time_) - elapsedSecsThisWeek(_time_))
+#define nextSunday(_time_) (previousSunday(_time_) + SECS_PER_WEEK)
+
+namespace shim {
+    inline time_t sysTime = 0;
+    inline unsigned long sysTimeMillis = 0;
+    inline timeStatus_t sysTimeStatus = timeNotSet;
+}
+
+inline void breakTime(time_t timeInput, tmElements_t &tm) {
+    struct tm t {};
+    gmtime_r(&timeInput, &t);
+    tm.Second = t.tm_sec;
+    tm.Minute = t.tm_min;
+    tm.Hour = t.tm_hour;
+    tm.Wday = t.tm_wday + 1;
+    tm.Day = t.tm_mday;
+    tm.Month = t.tm_mon + 1;
+    tm.Year = t.tm_year - 70;
+}
+inline time_t makeTime(const tmElements_t &tm) {
+    struct tm t {};
+    t.tm_sec = tm.Second;
+    t.tm_min = tm.Minute;
+    t.tm_hour = tm.Hour;
+    t.tm_mday = tm.Day;
+    t.tm_mon = tm.Month - 1;
+    t.tm_year = tm.Year + 70;
+    return timegm(&t);
+}
+inline time_t now() {
+    return shim::sysTime + (time_t)((millis() - shim::sysTimeMillis) / 1000);
+}
+inline void setTime(time_t t) {
+    shim::sysTime = t;
+    shim::sysTimeMillis = millis();
+    shim::sysTimeStatus = timeSet;
+}
+inline void setTime(int hr, int min, int sec, int dy, int mnth, int yr) {
+    tmElements_t tm {(uint8_t)sec, (uint8_t)min, (uint8_t)hr, 0, (uint8_t)dy, (uint8_t)mnth, (uint8_t)(yr > 99 ? yr - 1970 : yr + 30)};
+    setTime(makeTime(tm));
+}
+inline timeStatus_t timeStatus() { return shim::sysTimeStatus; }
+typedef time_t (*getExternalTime)();
+inline void setSyncProvider(getExternalTime) {}
+inline void setSyncInterval(time_t) {}
+
+inline int hour(time_t t) { tmElements_t tm; breakTime(t, tm); return tm.Hour; }
+inline int hourFormat12(time_t t) { const int h = hour(t); return h == 0 ? 12 : (h > 12 ? h - 12 : h); }
+inline bool isAM(time_t t) { return hour(t) < 12; }
+inline bool isPM(time_t t) { return hour(t) >= 12; }
+inline int minute(time_t t) { tmElements_t tm; breakTime(t, tm); return tm.Minute; }
+inline int second(time_t t) { tmElements_t tm; breakTime(t, tm); return tm.Second; }
+inline int day(time_t t) { tmElements_t tm; breakTime(t, tm); return tm.Day; }
+inline int weekday(time_t t) { tmElements_t tm; breakTime(t, tm); return tm.Wday; }
+inline int month(time_t t) { tmElements_t tm; breakTime(t, tm); return tm.Month; }
+inline int year(time_t t) { tmElements_t tm; breakTime(t, tm); return tmYearToCalendar(tm.Year); }
+inline int hour() { return hour(now()); }
+inline int hourFormat12() { return hourFormat12(now()); }
+inline bool isAM() { return isAM(now()); }
+inline bool isPM() { return isPM(now()); }
+inline int minute() { return minute(now()); }
+inline int second() { return second(now()); }
+inline int day() { return day(now()); }
+inline int weekday() { return weekday(now()); }
+inline int month() { return month(now()); }
+inline int year() { return year(now()); }
+
+#endif //TEEN_LIGHTFX_SHIM_TIMELIB_H
@@ -0,0 +1,10 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// ArduinoLog picks this header when ARDUINO is not defined - as in the native builds
+
+#ifndef TEEN_LIGHTFX_SHIM_WPROGRAM_H
+#define TEEN_LIGHTFX_SHIM_WPROGRAM_H
+
+#include <Arduino.h>
+
+#endif //TEEN_LIGHTFX_SHIM_WPROGRAM_H
@@ -0,0 +1,37 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the WiFi module - never connects
+
+#ifndef TEEN_LIGHTFX_SHIM_WIFININA_H
+#define TEEN_LIGHTFX_SHIM_WIFININA_H
+
+#include <Arduino.h>
+
+enum wl_status_t { WL_NO_SHIELD = 255, WL_NO_MODULE = WL_NO_SHIELD, WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED,
+    WL_CONNECT_FAILED, WL_CONNECTION_LOST, WL_DISCONNECTED };
+
+class UDP {
+public:
+    virtual ~UDP() = default;
+    virtual uint8_t begin(uint16_t) { return 0; }
+    virtual void stop() {}
+};
+
+class WiFiUDP : public UDP {};
+
+class WiFiServer {
+public:
+    explicit WiFiServer(uint16_t) {}
+    void begin() {}
+};
+
+class WiFiClass {
+public:
+    uint8_t status() { return WL_NO_MODULE; }
+    unsigned long getTime() { return 0; }
+    int32_t RSSI() { return 0; }
+};
+
+inline WiFiClass WiFi;
+
+#endif //TEEN_LIGHTFX_SHIM_WIFININA_H
@@ -0,0 +1,19 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Test fixture shared by the suites that run the effects engine on the host - sets the engine up once, against the recording LED sink
+// (see bench_setup). Suites needing more set up or tear down derive from it.
+
+#ifndef TEEN_LIGHTFX_SHIM_BENCH_FIXTURE_H
+#define TEEN_LIGHTFX_SHIM_BENCH_FIXTURE_H
+
+#include <gtest/gtest.h>
+#include "fxbench.h"
+
+class BenchFixture : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        bench_setup();
+    }
+};
+
+#endif //TEEN_LIGHTFX_SHIM_BENCH_FIXTURE_H
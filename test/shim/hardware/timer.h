@@ -0,0 +1,13 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the pico SDK timer - same clock as micros(), see Arduino.h
+
+#ifndef TEEN_LIGHTFX_SHIM_HARDWARE_TIMER_H
+#define TEEN_LIGHTFX_SHIM_HARDWARE_TIMER_H
+
+#include <Arduino.h>
+
+inline uint32_t time_us_32() { return (uint32_t)shim::clockUs(); }
+inline uint64_t time_us_64() { return shim::clockUs(); }
+
+#endif //TEEN_LIGHTFX_SHIM_HARDWARE_TIMER_H
@@ -0,0 +1,21 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Board level symbols the native builds do without - the network, web server and microphone units are not built for the host, the objects
+// they define for the effects engine are defined here instead. Include once, from the test suite's main translation unit.
+
+#ifndef TEEN_LIGHTFX_SHIM_HOST_BOARD_H
+#define TEEN_LIGHTFX_SHIM_HOST_BOARD_H
+
+#include "net_setup.h"
+#include "global.h"
+
+const CRGB CLR_ALL_OK = CRGB::Indigo;
+const CRGB CLR_SETUP_IN_PROGRESS = CRGB::Green;
+const CRGB CLR_SETUP_ERROR = CRGB::Red;
+
+WiFiUDP Udp;
+WiFiServer server(80);
+
+volatile uint16_t audioBumpThreshold = 2000;
+
+#endif //TEEN_LIGHTFX_SHIM_HOST_BOARD_H
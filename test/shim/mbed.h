@@ -0,0 +1,43 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the mbed OS services the effects engine uses - RTOS thread sleep and mutex, the default block device
+
+#ifndef TEEN_LIGHTFX_SHIM_MBED_H
+#define TEEN_LIGHTFX_SHIM_MBED_H
+
+#include <Arduino.h>
+#include <mutex>
+
+namespace rtos {
+    namespace ThisThread {
+        /**
+         * Sleeping advances the virtual clock - see Arduino.h
+         */
+        inline void sleep_for(std::chrono::milliseconds ms) { shim::advanceClock((uint64_t)ms.count() * 1000ull); }
+        inline const char *get_name() { return "host"; }
+    }
+
+    class Mutex {
+        std::recursive_mutex mtx;
+    public:
+        void lock() { mtx.lock(); }
+        bool trylock() { return mtx.try_lock(); }
+        void unlock() { mtx.unlock(); }
+    };
+}
+
+namespace mbed {
+    class BlockDevice {
+    public:
+        static BlockDevice *get_default_instance() { static BlockDevice bd; return &bd; }
+        int init() { return 0; }
+        int deinit() { return 0; }
+        const char *get_type() const { return "HOST"; }
+        uint64_t size() const { return 0; }
+        uint64_t get_read_size() const { return 1; }
+        uint64_t get_program_size() const { return 1; }
+        uint64_t get_erase_size() const { return 1; }
+    };
+}
+
+#endif //TEEN_LIGHTFX_SHIM_MBED_H
@@ -0,0 +1,37 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Host (native) stand-in for the pico SDK multicore support - the second core is a host thread. There is no flash to write on the host: the
+// lockout only checks the second core has registered as a victim (the board would wait for it) and flags the lockout for its duration
+
+#ifndef TEEN_LIGHTFX_SHIM_PICO_MULTICORE_H
+#define TEEN_LIGHTFX_SHIM_PICO_MULTICORE_H
+
+#include <Arduino.h>
+
+#define __not_in_flash_func(func_name)  func_name
+
+namespace shim {
+    inline thread_local bool onCore1 = false;
+    inline std::atomic<bool> lockoutVictim {false};
+    inline std::atomic<bool> lockedOut {false};
+}
+
+/**
+ * Runs the entry function on a detached host thread - it never returns, as on the board
+ */
+inline void multicore_launch_core1(void (*entry)()) {
+    std::thread([entry] {
+        shim::onCore1 = true;
+        entry();
+    }).detach();
+}
+inline uint get_core_num() { return shim::onCore1 ? 1 : 0; }
+inline void multicore_lockout_victim_init() { shim::lockoutVictim = true; }
+inline void multicore_lockout_start_blocking() {
+    while (!shim::lockoutVictim)
+        std::this_thread::yield();
+    shim::lockedOut = true;
+}
+inline void multicore_lockout_end_blocking() { shim::lockedOut = false; }
+
+#endif //TEEN_LIGHTFX_SHIM_PICO_MULTICORE_H
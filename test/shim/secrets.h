@@ -0,0 +1,11 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Native builds have no network - placeholder for the WiFi credentials kept out of the repository (include/secrets.h)
+
+#ifndef TEEN_LIGHTFX_SECRETS_H
+#define TEEN_LIGHTFX_SECRETS_H
+
+#define WF_SSID "native"
+#define WF_PSW  "native"
+
+#endif //TEEN_LIGHTFX_SECRETS_H
@@ -0,0 +1,11 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+
+#ifndef TEEN_LIGHTFX_SHIM_ECCX08DEFAULTTLSCONFIG_H
+#define TEEN_LIGHTFX_SHIM_ECCX08DEFAULTTLSCONFIG_H
+
+#include <Arduino.h>
+
+static const uint8_t ECCX08_DEFAULT_TLS_CONFIG[128] = {};
+
+#endif //TEEN_LIGHTFX_SHIM_ECCX08DEFAULTTLSCONFIG_H
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Blend modes - every pair of 8 bit operands (65536) through the color set blends, in every channel, against the blend mode formulas
+
+#include <gtest/gtest.h>
+#include "efx_setup.h"
+#include "host_board.h"
+
+#define PAIRS   65536
+
+/**
+ * Reference multiply - the operands are fractions of 256, 255 stands for 1.0
+ */
+static uint8_t refMul(const uint8_t a, const uint8_t b) {
+    if (a == 255)
+        return b;
+    if (b == 255)
+        return a;
+    return (a * b) / 256;
+}
+
+static uint8_t refScreen(const uint8_t a, const uint8_t b) {
+    return 255 - refMul(255 - a, 255 - b);
+}
+
+static uint8_t refOverlay(const uint8_t a, const uint8_t b) {
+    return a < 128 ? refMul(a, b) * 2 : 255 - refMul(255 - a, 255 - b) * 2;
+}
+
+static CRGB base[PAIRS], top[PAIRS];
+
+/**
+ * Fills the color sets with all the operand pairs - the first operand comes from the base set, the second from the top set. Each channel
+ * walks the pairs in a different order, such that a channel mix-up does not go unnoticed
+ */
+static void fillPairs() {
+    for (uint32_t x = 0; x < PAIRS; x++) {
+        const uint8_t a = x >> 8, b = x & 0xFF;
+        base[x] = CRGB(a, b, a ^ b);
+        top[x] = CRGB(b, a, ~b);
+    }
+}
+
+/**
+ * Blends all operand pairs through a color set blend, forward and reversed, and compares every channel with the reference formula
+ * @param setBlend color set blend under test
+ * @param ref reference formula of the blend mode
+ */
+static void expectAllPairs(void (*setBlend)(CRGBSet &, const CRGBSet &), uint8_t (*ref)(uint8_t, uint8_t)) {
+    for (const bool reversed : {false, true}) {
+        fillPairs();
+        CRGBSet baseSet = reversed ? CRGBSet(base, PAIRS - 1, 0) : CRGBSet(base, PAIRS);
+        const CRGBSet topSet = reversed ? CRGBSet(top, PAIRS - 1, 0) : CRGBSet(top, PAIRS);
+        setBlend(baseSet, topSet);
+        uint32_t mismatches = 0;
+        for (uint32_t x = 0; x < PAIRS; x++) {
+            const uint8_t a = x >> 8, b = x & 0xFF;
+            const CRGB expected(ref(a, b), ref(b, a), ref(a ^ b, ~b));
+            if (base[x] != expected && mismatches++ < 8)
+                ADD_FAILURE() << "a=" << (int)a << " b=" << (int)b << (reversed ? " reversed" : "") << " got (" << (int)base[x].r << ","
+                              << (int)base[x].g << "," << (int)base[x].b << ") expected (" << (int)expected.r << "," << (int)expected.g << ","
+                              << (int)expected.b << ")";
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+}
+
+TEST(Blend, MultiplyAllPairs) {
+    expectAllPairs(blendMultiply, refMul);
+}
+
+TEST(Blend, ScreenAllPairs) {
+    expectAllPairs(blendScreen, refScreen);
+}
+
+TEST(Blend, OverlayAllPairs) {
+    expectAllPairs(blendOverlay, refOverlay);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
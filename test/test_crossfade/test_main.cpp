@@ -0,0 +1,73 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Crossfade between effects - with the crossfade mode on, every registered effect is switched to through the effect registry; the frames
+// the incoming effect renders while the outgoing effect's last frame fades out are timed (render, blend and output curve together). Fails an
+// effect whose crossfaded frames exceed its frame budget, and an effect change that does not crossfade.
+
+#include <gtest/gtest.h>
+#include "bench_fixture.h"
+#include "host_board.h"
+
+#define XFADE_TEST_MS       1500    //crossfade duration enabled for the test
+#define XFADE_MAX_LOOPS     20000   //upper limit of registry loop iterations spent on one effect change
+#define XFADE_DRAIN_US      200     //real time given to the second core to pick the previous frame up before a frame is timed
+
+class CrossfadeTest : public BenchFixture {
+protected:
+    static void SetUpTestSuite() {
+        BenchFixture::SetUpTestSuite();
+        fxRegistry.crossfade(XFADE_TEST_MS);
+    }
+
+    static void TearDownTestSuite() {
+        fxRegistry.crossfade(FX_CROSSFADE_MS);
+    }
+};
+
+TEST_F(CrossfadeTest, CrossfadedFramesWithinBudget) {
+    ASSERT_EQ(fxRegistry.crossfadeTime(), XFADE_TEST_MS);
+    //the first effect runs before being switched from - an effect yet to be set up has no frame to fade out
+    for (uint16_t l = 0; (l < XFADE_MAX_LOOPS) && (fxRegistry.getCurrentEffect()->getState() != Running); l++)
+        fxRegistry.loop();
+    fxRegistry.loop();
+    uint16_t changes = 0;
+    benchForEachEffect([&changes](LedEffect *fx) {
+        const LedEffect *outgoing = fxRegistry.getCurrentEffect();
+        if (fx == outgoing)
+            return;
+        fxRegistry.nextEffectPos(fx->name());
+        uint32_t frames = 0, maxTime = 0;
+        uint64_t totalTime = 0;
+        bool faded = false;
+        for (uint16_t l = 0; l < XFADE_MAX_LOOPS; l++) {
+            const bool incoming = fxRegistry.getCurrentEffect() == fx && fx->getState() == Running;
+            const uint32_t framesBefore = stripOutput.frameCount();
+            //the time measured is the first core's alone - not waiting for the second core to take the previous frame over
+            std::this_thread::sleep_for(std::chrono::microseconds(XFADE_DRAIN_US));
+            const auto start = std::chrono::steady_clock::now();
+            fxRegistry.loop();
+            const auto dur = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            faded |= stripOutput.isCrossfading();
+            //the calls that only waited for the next frame are not counted
+            if (incoming && stripOutput.isCrossfading() && (stripOutput.frameCount() != framesBefore)) {
+                frames++;
+                totalTime += dur;
+                maxTime = max(maxTime, dur);
+            }
+            if (faded && !stripOutput.isCrossfading())
+                break;
+        }
+        printf("%-5s -> %-5s frames=%4u avg=%9uns max=%9uns budget=%4ums\n", outgoing->name(), fx->name(), frames,
+               (uint32_t)(frames ? totalTime / frames : 0), maxTime, fx->frameBudget());
+        EXPECT_TRUE(faded) << outgoing->name() << " -> " << fx->name() << " did not crossfade";
+        EXPECT_LE(maxTime, fx->frameBudget()*1000000u) << fx->name() << " longest crossfaded frame " << maxTime << "ns exceeds its "
+                                                        << fx->frameBudget() << "ms budget";
+        changes++;
+    });
+    EXPECT_GT(changes, 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Temporal dithering of the output stage - the 8 bit frames dithered out of a 16 bit frame average out to the 16 bit channel values, the
+// dithering pass fits the 100 FPS dithering frame time along with the wire time, the output stage's buffers fit their RAM allowance, and
+// only the dimmed frames are dithered and pushed again - until they settle.
+
+#include <gtest/gtest.h>
+#include "bench_fixture.h"
+#include "host_board.h"
+
+#define DITHER_TEST_PIXELS  NUM_PIXELS  //strip size the dithering is checked over
+#define DITHER_TEST_ROUNDS  50          //number of frames dithered for timing the pass
+#define OUTPUT_STAGE_RAM    (27*1024)   //static RAM allowance of the output stage - 24KB of pixel buffers at 1024 pixels, curves and state
+#define MAX_DITHER_PIXELS   320         //longest output dithered at 100 FPS - see StripOutput
+#define PUSH_TEST_STEPS     600         //dithering frame times a shown frame is watched for - over twice its settling pushes
+#define PUSH_DRAIN_US       200         //real time given to the second core to push a frame, each dithering frame time
+
+static CRGB16 src[MAX_NUM_PIXELS];
+static CRGB dest[MAX_NUM_PIXELS];
+static uint8_t residual[MAX_NUM_PIXELS*3];
+
+/**
+ * Fills the source frame with random channel values within the output curve's range
+ */
+static void randomFrame(const uint16_t szPixels) {
+    for (uint16_t x = 0; x < szPixels; x++)
+        src[x] = CRGB16(random16(0xFF01), random16(0xFF01), random16(0xFF01));
+}
+
+TEST(DitherTest, AveragesToSourceChannels) {
+    random16_set_seed(0x5EED);
+    randomFrame(DITHER_TEST_PIXELS);
+    memset(residual, 0, sizeof(residual));
+    uint32_t sums[DITHER_TEST_PIXELS*3] {};
+    for (uint16_t f = 1; f <= 256; f++) {
+        StripOutput::ditherFrame(dest, src, residual, DITHER_TEST_PIXELS);
+        const auto *s = (const uint16_t *)src;
+        const auto *d = (const uint8_t *)dest;
+        for (uint16_t ch = 0; ch < DITHER_TEST_PIXELS*3; ch++) {
+            //every frame is the channel's 8 bit floor or ceiling, and the running sum never strays a whole step off the exact one
+            ASSERT_GE(d[ch], s[ch] >> 8) << "channel " << ch << " frame " << f;
+            ASSERT_LE(d[ch], (s[ch] + 0xFF) >> 8) << "channel " << ch << " frame " << f;
+            sums[ch] += d[ch];
+            const uint32_t exact = (uint32_t)s[ch] * f;
+            ASSERT_LE(sums[ch] * 256, exact) << "channel " << ch << " frame " << f;
+            ASSERT_GT(sums[ch] * 256 + 256, exact) << "channel " << ch << " frame " << f;
+        }
+    }
+    //over 256 frames the 8 bit channels add up to the 16 bit channels exactly, residuals drained
+    for (uint16_t ch = 0; ch < DITHER_TEST_PIXELS*3; ch++) {
+        EXPECT_EQ(sums[ch], ((const uint16_t *)src)[ch]) << "channel " << ch;
+        EXPECT_EQ(residual[ch], 0) << "channel " << ch;
+    }
+}
+
+TEST(DitherTest, RoundsWithoutResidual) {
+    random16_set_seed(0xD17E);
+    randomFrame(DITHER_TEST_PIXELS);
+    StripOutput::ditherFrame(dest, src, nullptr, DITHER_TEST_PIXELS);
+    const auto *s = (const uint16_t *)src;
+    const auto *d = (const uint8_t *)dest;
+    for (uint16_t ch = 0; ch < DITHER_TEST_PIXELS*3; ch++)
+        EXPECT_EQ(d[ch], (s[ch] + 0x80) >> 8) << "channel " << ch;
+}
+
+TEST(DitherTest, FitsDitherFrameTime) {
+    randomFrame(MAX_NUM_PIXELS);
+    const uint16_t sizes[] = {DITHER_TEST_PIXELS, MAX_NUM_PIXELS};
+    for (uint16_t sz : sizes) {
+        const ulong start = micros();
+        for (uint16_t r = 0; r < DITHER_TEST_ROUNDS; r++)
+            StripOutput::ditherFrame(dest, src, residual, sz);
+        const uint32_t ditherTime = (micros() - start) / DITHER_TEST_ROUNDS;
+        const uint32_t oneOutput = ditherTime + StripOutput::wireTime(sz);
+        const uint32_t perOutput = ditherTime + StripOutput::wireTime((sz + MAX_LED_OUTPUTS - 1) / MAX_LED_OUTPUTS);
+        printf("pixels=%4u dither=%5uus push on 1 output=%5uus on %d outputs=%5uus\n", sz, ditherTime, oneOutput, MAX_LED_OUTPUTS, perOutput);
+        EXPECT_LE(perOutput, DITHER_FRAME_TIME_US) << sz << " pixels over " << MAX_LED_OUTPUTS << " outputs do not dither at 100 FPS";
+        if (sz <= MAX_DITHER_PIXELS)
+            EXPECT_LE(oneOutput, DITHER_FRAME_TIME_US) << sz << " pixels on one output do not dither at 100 FPS";
+        else
+            EXPECT_GT(oneOutput, DITHER_FRAME_TIME_US) << "documented single output limit of " << MAX_DITHER_PIXELS << " pixels is out of date";
+    }
+    //the longest output dithered at 100 FPS - the wire time leaves some room for the dithering pass
+    EXPECT_LE(StripOutput::wireTime(MAX_DITHER_PIXELS), DITHER_FRAME_TIME_US);
+    EXPECT_GT(StripOutput::wireTime(MAX_DITHER_PIXELS + 20), DITHER_FRAME_TIME_US);
+}
+
+TEST(DitherTest, OutputStageWithinRamAllowance) {
+    printf("output stage static RAM=%uB, allowance %uB\n", (uint32_t)sizeof(StripOutput), (uint32_t)OUTPUT_STAGE_RAM);
+    EXPECT_LE(sizeof(StripOutput), (size_t)OUTPUT_STAGE_RAM);
+}
+
+/**
+ * Steps the clock a dithering frame time at a time, giving the second core the real time to push a frame at every step
+ * @param steps number of dithering frame times to step through
+ * @param untilIdle stop early, once a step pushes no frame
+ * @return number of frames pushed to the strip meanwhile
+ */
+static uint32_t stepPushes(const uint16_t steps, const bool untilIdle = false) {
+    const uint32_t framesStart = benchSink.frames;
+    for (uint16_t s = 0; s < steps; s++) {
+        const uint32_t framesBefore = benchSink.frames;
+        shim::advanceClock(DITHER_FRAME_TIME_US);
+        std::this_thread::sleep_for(std::chrono::microseconds(PUSH_DRAIN_US));
+        if (untilIdle && (benchSink.frames == framesBefore))
+            break;
+    }
+    return benchSink.frames - framesStart;
+}
+
+using DitherPushTest = BenchFixture;
+
+TEST_F(DitherPushTest, StaticFramesHeld) {
+    stripOutput.setTemplate(0);
+    stripOutput.setHighRes(false);
+    stepPushes(PUSH_TEST_STEPS, true);
+    //a frame above the dithering brightness is pushed once, rounded - not again while it stays on
+    for (uint16_t x = 0; x < numPixels; x++)
+        leds[x] = CRGB(x, 0x80, 0xFF - x);
+    stripOutput.show(255);
+    EXPECT_EQ(stepPushes(PUSH_TEST_STEPS), 1u) << "static frame at full brightness pushed again";
+    //a dimmed frame is dithered and pushed again until it settles, then pushed once more rounded and held
+    for (uint16_t x = 0; x < numPixels; x++)
+        leds[x] = CRGB(0x40, x, 0x20);
+    stripOutput.show(DITHER_MAX_BRIGHTNESS / 2);
+    EXPECT_EQ(stepPushes(PUSH_TEST_STEPS), DITHER_SETTLE_FRAMES + 1u) << "static dimmed frame not settled";
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Easing tables against the floating point easing functions they replace - every table entry is compared with the double precision curves
+// within one Q16 unit, positions interpolated in between within the maximum errors stated in easing.cpp. The scaled helpers (easeOutQuad,
+// easeOutBounce) are compared with their former float implementations, and every curve is checked to start at 0 and end at its maximum.
+
+#include <gtest/gtest.h>
+#include "easing.h"
+#include "efx_setup.h"
+#include "host_board.h"
+
+#define EASE_INTERP_STEP    17      //Q16 position step of the interpolated positions checked - odd, lands between table entries
+#define EASE_MAX_ERR_ENTRY  (1.0/EASE_ONE)  //max error of a table entry - rounded to Q16 from the compile time evaluation
+#define EASE_MAX_ERR_POLY   0.0001  //max error of the quad, cubic and sine curves, in units of 1.0
+#define EASE_MAX_ERR_ELASTIC 0.001  //max error of the elastic curves
+#define EASE_MAX_ERR_BOUNCE 0.003   //max error of the in and out bounce curves
+#define EASE_MAX_ERR_BOUNCE_INOUT 0.008 //max error of the in-out bounce curve - the error concentrates at the bounce cusps
+
+static double outBounce(double x) {
+    const double n1 = 7.5625;
+    const double d1 = 2.75;
+    if (x < 1/d1)
+        return n1*x*x;
+    if (x < 2/d1) {
+        x -= 1.5/d1;
+        return n1*x*x + 0.75;
+    }
+    if (x < 2.5/d1) {
+        x -= 2.25/d1;
+        return n1*x*x + 0.9375;
+    }
+    x -= 2.625/d1;
+    return n1*x*x + 0.984375;
+}
+
+/**
+ * The easing curves in double precision, per https://easings.net
+ */
+static double refEase(const EaseCurve curve, const double x) {
+    const double c4 = 2*M_PI/3;
+    const double c5 = 2*M_PI/4.5;
+    switch (curve) {
+        case EaseInQuad: return x*x;
+        case EaseOutQuad: return 1 - (1-x)*(1-x);
+        case EaseInOutQuad: return x < 0.5 ? 2*x*x : 1 - pow(-2*x + 2, 2)/2;
+        case EaseInCubic: return x*x*x;
+        case EaseOutCubic: return 1 - pow(1-x, 3);
+        case EaseInOutCubic: return x < 0.5 ? 4*x*x*x : 1 - pow(-2*x + 2, 3)/2;
+        case EaseInSine: return 1 - cos(x*M_PI/2);
+        case EaseOutSine: return sin(x*M_PI/2);
+        case EaseInOutSine: return -(cos(M_PI*x) - 1)/2;
+        case EaseInBounce: return 1 - outBounce(1-x);
+        case EaseOutBounce: return outBounce(x);
+        case EaseInOutBounce: return x < 0.5 ? (1 - outBounce(1 - 2*x))/2 : (1 + outBounce(2*x - 1))/2;
+        case EaseInElastic: return x <= 0 ? 0 : x >= 1 ? 1 : -pow(2, 10*x - 10) * sin((x*10 - 10.75)*c4);
+        case EaseOutElastic: return x <= 0 ? 0 : x >= 1 ? 1 : pow(2, -10*x) * sin((x*10 - 0.75)*c4) + 1;
+        case EaseInOutElastic: return x <= 0 ? 0 : x >= 1 ? 1 : x < 0.5 ? -(pow(2, 20*x - 10) * sin((20*x - 11.125)*c5))/2
+                                                                        : (pow(2, -20*x + 10) * sin((20*x - 11.125)*c5))/2 + 1;
+        default: return x;
+    }
+}
+
+static double maxError(const EaseCurve curve) {
+    switch (curve) {
+        case EaseInBounce:
+        case EaseOutBounce: return EASE_MAX_ERR_BOUNCE;
+        case EaseInOutBounce: return EASE_MAX_ERR_BOUNCE_INOUT;
+        case EaseInElastic:
+        case EaseOutElastic:
+        case EaseInOutElastic: return EASE_MAX_ERR_ELASTIC;
+        default: return EASE_MAX_ERR_POLY;
+    }
+}
+
+/**
+ * Ease Out Quad in floating point - the implementation the easing tables replaced
+ */
+static uint16_t floatEaseOutQuad(const uint16_t x, const uint16_t lim) {
+    auto limf = float(lim);
+    float xf = float(x)/limf;
+    return uint16_t((1 - (1-xf)*(1-xf))*limf);
+}
+
+/**
+ * Ease Out Bounce in floating point - the implementation the easing tables replaced
+ */
+static uint16_t floatEaseOutBounce(const uint16_t x, const uint16_t lim) {
+    return (uint16_t)(float(outBounce(double(float(x)/float(lim)))) * (float)lim);
+}
+
+TEST(EasingTest, TableEntriesMatchCurves) {
+    for (uint8_t c = 0; c < EaseCurveCount; c++) {
+        const auto curve = (EaseCurve)c;
+        double worst = 0;
+        for (uint32_t x = 0; x <= EASE_TABLE_SIZE; x++) {
+            const uint32_t pos = x << EASE_FRAC_BITS;
+            const double err = fabs(double(easeQ16(curve, pos)) / EASE_ONE - refEase(curve, double(pos) / EASE_ONE));
+            worst = fmax(worst, err);
+            EXPECT_LE(err, EASE_MAX_ERR_ENTRY) << "curve " << (int)c << " table entry " << x;
+        }
+        printf("curve %2d table entries max error=%.6f\n", c, worst);
+    }
+}
+
+TEST(EasingTest, InterpolatedPositionsMatchCurves) {
+    for (uint8_t c = 0; c < EaseCurveCount; c++) {
+        const auto curve = (EaseCurve)c;
+        double worst = 0;
+        for (uint32_t pos = 0; pos <= (uint32_t)EASE_ONE; pos += EASE_INTERP_STEP) {
+            const double err = fabs(double(easeQ16(curve, pos)) / EASE_ONE - refEase(curve, double(pos) / EASE_ONE));
+            worst = fmax(worst, err);
+            ASSERT_LE(err, maxError(curve)) << "curve " << (int)c << " position " << pos;
+        }
+        printf("curve %2d interpolated max error=%.6f\n", c, worst);
+    }
+}
+
+TEST(EasingTest, EndpointsExact) {
+    for (uint8_t c = 0; c < EaseCurveCount; c++) {
+        const auto curve = (EaseCurve)c;
+        EXPECT_EQ(easeQ16(curve, 0), 0) << "curve " << (int)c;
+        EXPECT_EQ(easeQ16(curve, EASE_ONE), EASE_ONE) << "curve " << (int)c;
+        EXPECT_EQ(ease16(curve, 0), 0) << "curve " << (int)c;
+        EXPECT_EQ(ease16(curve, 0xFFFF), 0xFFFF) << "curve " << (int)c;
+        for (const uint16_t lim : {1, 7, 100, 170, 255, 1024, 0xFFFF}) {
+            EXPECT_EQ(ease(curve, 0, lim), 0) << "curve " << (int)c << " lim " << lim;
+            EXPECT_EQ(ease(curve, lim, lim), lim) << "curve " << (int)c << " lim " << lim;
+        }
+    }
+}
+
+TEST(EasingTest, ScaledHelpersMatchFloat) {
+    //the float implementations truncated, the tables round - one unit apart at most, plus the table error scaled to the range
+    for (const uint16_t lim : {100, 170, 255, 1024}) {
+        for (uint16_t x = 0; x <= lim; x++) {
+            EXPECT_NEAR(easeOutQuad(x, lim), floatEaseOutQuad(x, lim), 1 + EASE_MAX_ERR_POLY*lim) << "x " << x << " lim " << lim;
+            EXPECT_NEAR(easeOutBounce(x, lim), floatEaseOutBounce(x, lim), 1 + EASE_MAX_ERR_BOUNCE*lim) << "x " << x << " lim " << lim;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Effects benchmark on the host - every registered effect renders a number of frames off-screen; the frames the output stage pushes through
+// FastLED.show() land in the recording LED sink. Reports ns/frame, allocations and peak stack per effect and fails an effect over its frame budget.
+
+#include "bench_fixture.h"
+#include "host_board.h"
+
+#define HOST_BENCH_FRAMES   200     //number of frames each effect renders
+#define HOST_SHOW_LOOPS     500     //number of effect loop iterations run against the recording sink
+
+using FxBenchTest = BenchFixture;
+
+TEST_F(FxBenchTest, EffectsWithinFrameBudget) {
+    uint16_t benchCount = 0;
+    benchForEachEffect([&benchCount](LedEffect *fx) {
+        const FxBenchResult res = benchEffect(fx, HOST_BENCH_FRAMES);
+        const auto avgFrameTime = (uint32_t)(res.frames ? res.totalTime / res.frames : 0);
+        printf("%-5s frames=%4u avg=%9uns max=%9uns budget=%4ums heap=%+6dB allocs=%3u stack=%4uB\n", fx->name(), res.frames, avgFrameTime,
+               res.maxFrameTime, fx->frameBudget(), res.heapDelta, res.allocations, res.peakStack);
+        EXPECT_TRUE(benchWithinBudget(fx, res)) << fx->name() << " longest frame " << res.maxFrameTime << "ns exceeds its "
+                                                << fx->frameBudget() << "ms budget";
+        EXPECT_LT(res.peakStack, BENCH_STACK_PROBE_SIZE) << fx->name() << " stack usage reached the probed area's limit";
+        benchCount++;
+    });
+    EXPECT_GT(benchCount, 0);
+}
+
+TEST_F(FxBenchTest, FramesReachRecordingSink) {
+    const uint32_t framesStart = benchSink.frames;
+    for (uint16_t x = 0; x < HOST_SHOW_LOOPS; x++) {
+        fx_run();
+        yield();
+    }
+    //the second core pushes the frames asynchronously - give it time to drain the queue
+    for (uint16_t x = 0; (x < 1000) && (benchSink.frames == framesStart); x++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_GT(benchSink.frames, framesStart);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
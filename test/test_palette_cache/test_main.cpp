@@ -0,0 +1,78 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Palette cache lookups against FastLED's ColorFromPalette - every index at every brightness, for a few palettes. Counts the cache refreshes
+// while a timed palette blend runs under an effect looking up a single color per frame.
+
+#include <gtest/gtest.h>
+#include "PaletteFactory.h"
+#include "host_board.h"
+
+#define BLEND_FRAME_MS      50      //frame period the blend is updated at - the effects blending palettes render at 20 FPS
+
+/**
+ * Compares every lookup served from the palette cache with the equivalent <code>ColorFromPalette</code> call
+ * @param pal palette to make current
+ */
+static void expectCacheMatches(const CRGBPalette16 &pal) {
+    paletteBlender.setPalette(pal);
+    for (uint16_t bright = 0; bright < 256; bright++) {
+        for (uint16_t index = 0; index < 256; index++) {
+            const CRGB cached = ColorFromCache(palette, index, bright);
+            const CRGB expected = ColorFromPalette(palette, index, bright, LINEARBLEND);
+            ASSERT_EQ(cached, expected) << "index=" << index << " brightness=" << bright;
+        }
+    }
+}
+
+TEST(PaletteCache, MatchesColorFromPaletteRainbow) {
+    expectCacheMatches(RainbowColors_p);
+}
+
+TEST(PaletteCache, MatchesColorFromPaletteLava) {
+    expectCacheMatches(LavaColors_p);
+}
+
+TEST(PaletteCache, MatchesColorFromPaletteRandom) {
+    random16_set_seed(1234);
+    for (uint8_t r = 0; r < 8; r++) {
+        CRGBPalette16 pal;
+        for (auto &entry : pal.entries)
+            entry = CRGB(random8(), random8(), random8());
+        expectCacheMatches(pal);
+    }
+}
+
+TEST(PaletteCache, FollowsPaletteChanges) {
+    paletteBlender.setPalette(OceanColors_p);
+    const CRGB before = ColorFromCache(palette, 100, 200);
+    paletteBlender.setPalette(HeatColors_p);
+    EXPECT_EQ(ColorFromCache(palette, 100, 200), ColorFromPalette(HeatColors_p, 100, 200, LINEARBLEND));
+    EXPECT_NE(ColorFromCache(palette, 100, 200), before);
+}
+
+TEST(PaletteCache, BlendRefreshesInSteps) {
+    paletteBlender.setPalette(OceanColors_p);
+    paletteBlender.setTarget(LavaColors_p);
+    paletteBlender.blendOver(paletteBlendTime);
+    const uint32_t refreshStart = paletteCache.refreshCount();
+    uint32_t frames = 0;
+    for (ulong t = 0; t <= paletteBlendTime; t += BLEND_FRAME_MS, frames++) {
+        paletteBlender.update();
+        ColorFromCache(palette, frames, 255);
+        delay(BLEND_FRAME_MS);
+    }
+    paletteBlender.update();
+    ColorFromCache(palette, 0, 255);
+    const uint32_t refreshes = paletteCache.refreshCount() - refreshStart;
+    printf("blend=%ums frames=%u cache refreshes=%u (%.2f/s)\n", paletteBlendTime, frames, refreshes, refreshes * 1000.0 / paletteBlendTime);
+    EXPECT_TRUE(paletteBlender.isConverged());
+    EXPECT_EQ(ColorFromCache(palette, 100, 200), ColorFromPalette(LavaColors_p, 100, 200, LINEARBLEND));
+    //one refresh per blend step, the first lookup and the final snap to the target
+    EXPECT_LE(refreshes, PALETTE_BLEND_STEPS + 1);
+    EXPECT_LT(refreshes * 10, frames);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Fixed point particle physics against the floating point physics FxF5 was ported from - explosions stepped through particlesStep in
+// Q16.16 and through the float kernel from the same initial conditions. Fails a position drifting more than PARTICLE_MAX_DRIFT pixels
+// off the float one, and counts of active particles more than one apart.
+
+#include <gtest/gtest.h>
+#include "particles.h"
+#include "fxF.h"
+#include "host_board.h"
+
+#define PARTICLE_COUNT      64      //particles in each explosion
+#define PARTICLE_ROUNDS     50      //number of explosions stepped
+#define PARTICLE_MAX_DRIFT  0.25f   //largest position difference allowed between the fixed and floating point particles, in pixels
+
+/**
+ * Floating point particle - the representation FxF5 used before the fixed point particle system
+ */
+struct FloatParticle {
+    float pos;
+    float velocity;
+};
+
+TEST(ParticlesTest, FixedPointTracksFloat) {
+    random16_set_seed(0x5EED);
+    static FloatParticle flParticles[PARTICLE_COUNT];
+    static Particle fxParticles[PARTICLE_COUNT];
+    const uint16_t limit = FRAME_SIZE - 1;
+    float maxDrift = 0;
+    for (uint16_t r = 0; r < PARTICLE_ROUNDS; r++) {
+        //explosion at a random height, sparks velocity from -1 to 1 pixel/frame - as FxF5's explodePrep
+        const uint16_t height = random16(FRAME_SIZE*3/10, FRAME_SIZE*8/10);
+        for (uint16_t x = 0; x < PARTICLE_COUNT; x++) {
+            const uint16_t vel = random16(0, 20000);
+            flParticles[x] = {float(height), (float(vel) / 10000.0f) - 1.0f};
+            fxParticles[x].pos = toFix16(height);
+            fxParticles[x].velocity = fix16Ratio(vel, 10000) - FIX16_ONE;
+        }
+        float flGravity = -.004f;
+        DecayingFix16 fxGravity(TO_FIX16(-.004f));
+        for (uint16_t s = 0; s < FXF5_EXPLODE_STEPS; s++) {
+            uint16_t flActive = 0;
+            for (auto &p : flParticles) {
+                p.pos = constrain(p.pos + p.velocity, 0, float(limit));
+                p.velocity += flGravity;
+                flActive += p.pos >= 1.0f;
+            }
+            flGravity *= 0.985f;
+            const uint16_t fxActive = particlesStep(fxParticles, PARTICLE_COUNT, fxGravity.value(), toFix16(limit));
+            fxGravity.decay(FIX16_DECAY(.985f));
+            for (uint16_t x = 0; x < PARTICLE_COUNT; x++) {
+                const float drift = fabsf(float(fxParticles[x].pos) / 65536.0f - flParticles[x].pos);
+                maxDrift = max(maxDrift, drift);
+                ASSERT_LE(drift, PARTICLE_MAX_DRIFT) << "particle " << x << " step " << s << " round " << r;
+            }
+            //a particle right at the bottom pixel's edge may land either side of it
+            EXPECT_NEAR(fxActive, flActive, 1) << "step " << s << " round " << r;
+        }
+    }
+    printf("particles=%d rounds=%d steps=%d max drift=%.4f pixels\n", PARTICLE_COUNT, PARTICLE_ROUNDS, FXF5_EXPLODE_STEPS, maxDrift);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
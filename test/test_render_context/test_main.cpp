@@ -0,0 +1,125 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Effects rendering through the render context - off-screen renders leave the strip's pixel buffers untouched, effects rendering a template
+// report its size in the context and the effect registry engages the output stage's template mode from it, FxB3's turn off runs as a wind
+// down that resumes the effect.
+
+#include <gtest/gtest.h>
+#include "bench_fixture.h"
+#include "host_board.h"
+
+#define CTX_TEST_FRAMES     300     //number of frames each effect renders off-screen
+#define CTX_MAX_LOOPS       20000   //upper limit of registry loop iterations spent waiting for an effect state
+#define CTX_SENTINEL        CRGB(0x5A, 0xA5, 0x3C)  //strip content the off-screen renders must leave in place
+
+static CRGB ctxFrame[MAX_NUM_PIXELS];
+
+class RenderContextTest : public BenchFixture {
+protected:
+    /**
+     * Steps the effect registry until the effect given is the current one and runs
+     * @param id effect identifier
+     * @return the effect, running; nullptr if not found or not running within the loop limit
+     */
+    static LedEffect *runEffect(const char *id) {
+        LedEffect *fx = fxRegistry.findEffect(id);
+        if (fx == nullptr)
+            return nullptr;
+        fxRegistry.nextEffectPos(id);
+        for (uint16_t l = 0; l < CTX_MAX_LOOPS; l++) {
+            fxRegistry.loop();
+            if ((fxRegistry.getCurrentEffect() == fx) && (fx->getState() == Running))
+                return fx;
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(RenderContextTest, OffScreenRenderLeavesStrip) {
+    benchForEachEffect([](LedEffect *fx) {
+        fx->setup();
+        //the effect's setup may engage output stage modes - the buffers are painted after it
+        const uint16_t tplSize = stripOutput.templateSize();
+        fill_solid(leds, numPixels, CTX_SENTINEL);
+        CRGB16 *px16 = stripOutput.highResBuffer();
+        const CRGB16 sentinel16(CTX_SENTINEL);
+        for (uint16_t p = 0; p < numPixels; p++)
+            px16[p] = sentinel16;
+        CRGBSet target(ctxFrame, numPixels);
+        CRGBSet frameTpl(ctxFrame, tpl.size());
+        CRGBSet frameOthers(ctxFrame + tpl.size(), numPixels - tpl.size());
+        target = CRGB::Black;
+        uint16_t rendered = 0;
+        for (uint16_t f = 0; f < CTX_TEST_FRAMES; f++) {
+            RenderContext ctx {target, frameTpl, frameOthers, palette, millis(), 10, stripBrightness, 0, nullptr};
+            if (fx->run(ctx)) {
+                rendered++;
+                EXPECT_TRUE((ctx.templateSize == 0) || (ctx.templateSize == frameTpl.size())) << fx->name() << " template size " << ctx.templateSize;
+            }
+            delay(10);
+        }
+        uint16_t touched = 0, touched16 = 0;
+        for (uint16_t p = 0; p < numPixels; p++) {
+            touched += leds[p] != CTX_SENTINEL;
+            touched16 += (px16[p].r != sentinel16.r) || (px16[p].g != sentinel16.g) || (px16[p].b != sentinel16.b);
+        }
+        EXPECT_EQ(touched, 0) << fx->name() << " rendered into the strip's pixel buffer";
+        EXPECT_EQ(touched16, 0) << fx->name() << " rendered into the output stage's high resolution buffer";
+        EXPECT_EQ(stripOutput.templateSize(), tplSize) << fx->name() << " changed the output stage's template mode while rendering";
+        printf("%-5s frames=%4u\n", fx->name(), rendered);
+    });
+}
+
+TEST_F(RenderContextTest, SleepLightRendersIntoTarget) {
+    LedEffect *fx = fxRegistry.findEffect(FX_SLEEPLIGHT_ID);
+    ASSERT_NE(fx, nullptr);
+    fx->setup();
+    CRGBSet target(ctxFrame, numPixels);
+    CRGBSet frameTpl(ctxFrame, tpl.size());
+    CRGBSet frameOthers(ctxFrame + tpl.size(), numPixels - tpl.size());
+    target = CRGB::Black;
+    for (uint16_t f = 0; f < CTX_TEST_FRAMES; f++) {
+        RenderContext ctx {target, frameTpl, frameOthers, palette, millis(), 125, stripBrightness, 0, nullptr};
+        ASSERT_TRUE(fx->run(ctx));
+        delay(125);
+    }
+    uint16_t lit = 0;
+    for (uint16_t p = 0; p < numPixels; p++)
+        lit += target[p].getLuma() > 0;
+    EXPECT_EQ(lit, numPixels) << "the sleep light fades in over the whole frame";
+}
+
+TEST_F(RenderContextTest, RegistryForwardsTemplateSize) {
+    for (const char *id : {"FxD4", "FxF1"}) {
+        LedEffect *fx = runEffect(id);
+        ASSERT_NE(fx, nullptr) << id << " did not start running";
+        const uint32_t frames = stripOutput.frameCount();
+        for (uint16_t l = 0; (l < CTX_MAX_LOOPS) && (stripOutput.frameCount() == frames); l++)
+            fxRegistry.loop();
+        EXPECT_EQ(stripOutput.templateSize(), tpl.size()) << id << " frames are not shown in template mode";
+    }
+    LedEffect *fx = runEffect("FXB1");
+    ASSERT_NE(fx, nullptr);
+    EXPECT_EQ(stripOutput.templateSize(), 0) << "template mode outlived the effect that rendered the template";
+}
+
+TEST_F(RenderContextTest, TurnOffResumesEffect) {
+    LedEffect *fx = runEffect("FXB3");
+    ASSERT_NE(fx, nullptr);
+    bool woundDown = false, resumed = false;
+    for (uint32_t l = 0; (l < 20*CTX_MAX_LOOPS) && !resumed; l++) {
+        fxRegistry.loop();
+        ASSERT_EQ(fxRegistry.getCurrentEffect(), fx);
+        const EffectState st = fx->getState();
+        ASSERT_TRUE((st == Running) || (st == WindDownPrep) || (st == WindDown)) << "turn off went past the wind down, state " << st;
+        woundDown |= st == WindDown;
+        resumed = woundDown && (st == Running);
+    }
+    EXPECT_TRUE(woundDown) << "FXB3 did not turn off";
+    EXPECT_TRUE(resumed) << "FXB3 did not resume after turning off";
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
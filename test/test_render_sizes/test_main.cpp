@@ -0,0 +1,115 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Effects rendering over strip sizes other than the board's - the strip is laid out over 50 (template covering the whole strip), 170, 512
+// and 1024 pixels, every registered effect renders a number of frames off-screen at each size. Fails an effect over its frame budget at any
+// size, and the effects' frame times growing faster than the strip does. The random bars transition runs across layout changes and must
+// turn the whole strip off, its bars spanning the strip as laid out.
+
+#include <gtest/gtest.h>
+#include "bench_fixture.h"
+#include "host_board.h"
+
+#define HOST_BENCH_FRAMES   200     //number of frames each effect renders at each strip size
+#define SCALING_REF_PIXELS  NUM_PIXELS  //strip size the frame times at the other sizes are compared against
+#define SCALING_TOLERANCE   2       //factor the frame time at a strip size may exceed the linear extrapolation from the reference size
+#define MAX_TRANSITION_FRAMES   2000    //upper limit of frames run for a transition to complete
+
+static const uint16_t stripSizes[] = {50, SCALING_REF_PIXELS, 512, MAX_NUM_PIXELS};
+
+class RenderSizesTest : public BenchFixture {
+protected:
+    static void TearDownTestSuite() {
+        benchLayout(NUM_PIXELS);
+    }
+
+    /**
+     * Renders every registered effect at the active strip size
+     * @return sum over all effects of the average frame time, in ns
+     */
+    static uint64_t renderAll() {
+        uint64_t sumAvg = 0;
+        benchForEachEffect([&sumAvg](LedEffect *fx) {
+            const FxBenchResult res = benchEffect(fx, HOST_BENCH_FRAMES);
+            const uint64_t avgFrameTime = res.frames ? res.totalTime / res.frames : 0;
+            printf("pixels=%4u %-5s frames=%4u avg=%9uns max=%9uns budget=%4ums\n", numPixels, fx->name(), res.frames, (uint32_t)avgFrameTime,
+                   res.maxFrameTime, fx->frameBudget());
+            EXPECT_TRUE(benchWithinBudget(fx, res)) << fx->name() << " longest frame " << res.maxFrameTime << "ns at " << numPixels
+                                                    << " pixels exceeds its " << fx->frameBudget() << "ms budget";
+            sumAvg += avgFrameTime;
+        });
+        return sumAvg;
+    }
+};
+
+TEST_F(RenderSizesTest, FrameTimeScalesLinearly) {
+    uint64_t frameTimes[sizeof(stripSizes)/sizeof(stripSizes[0])] {};
+    uint64_t refTime = 0;
+    for (uint8_t x = 0; x < sizeof(stripSizes)/sizeof(stripSizes[0]); x++) {
+        const uint16_t pixels = stripSizes[x];
+        ASSERT_TRUE(benchLayout(pixels)) << "layout of " << pixels << " pixels rejected";
+        ASSERT_EQ(numPixels, pixels);
+        EXPECT_EQ(tpl.size(), min((uint16_t)FRAME_SIZE, pixels));
+        EXPECT_EQ(tpl.size() + others.size(), pixels);
+        frameTimes[x] = renderAll();
+        if (pixels == SCALING_REF_PIXELS)
+            refTime = frameTimes[x];
+    }
+    ASSERT_GT(refTime, 0u) << "reference strip size was not rendered";
+    for (uint8_t x = 0; x < sizeof(stripSizes)/sizeof(stripSizes[0]); x++) {
+        const uint16_t pixels = stripSizes[x];
+        //fixed per frame costs dominate short strips - below the reference size, the frame time is only bound by the reference's
+        const uint64_t limit = refTime * max(pixels, (uint16_t)SCALING_REF_PIXELS) / SCALING_REF_PIXELS * SCALING_TOLERANCE;
+        printf("pixels=%4u all effects avg=%9uns/frame linear limit=%9uns/frame\n", pixels, (uint32_t)frameTimes[x], (uint32_t)limit);
+        EXPECT_LE(frameTimes[x], limit) << "effects' frame time at " << pixels << " pixels grows faster than the strip";
+    }
+}
+
+/**
+ * Transition exposing the random bars' span - the sum of their sizes
+ */
+class BarsTransition : public EffectTransition {
+public:
+    uint16_t barsSpan() const {
+        uint16_t span = 0;
+        for (uint16_t b = 0; b < barCount; b++)
+            span += barSizes[b];
+        return span;
+    }
+};
+
+static BarsTransition barsTransition;
+
+/**
+ * Lights up the strip and runs a transition on it until complete
+ * @param selector transition selector - see <code>EffectTransition::prepare</code>
+ * @return whether the transition has completed within <code>MAX_TRANSITION_FRAMES</code>
+ */
+static bool runTransition(const uint selector) {
+    fill_solid(leds, MAX_NUM_PIXELS, CRGB::White);
+    barsTransition.prepare(selector);
+    for (uint16_t f = 0; f < MAX_TRANSITION_FRAMES; f++) {
+        shim::advanceClock(50000);
+        if (barsTransition.transition())
+            return true;
+    }
+    return false;
+}
+
+TEST_F(RenderSizesTest, RandomBarsFollowLayout) {
+    barsTransition.setup();
+    //growing, then shrinking the strip - the split transition leaves its own plan behind for the random bars to overwrite
+    const uint16_t layouts[] = {SCALING_REF_PIXELS, MAX_NUM_PIXELS, 50};
+    for (uint16_t pixels : layouts) {
+        ASSERT_TRUE(benchLayout(pixels)) << "layout of " << pixels << " pixels rejected";
+        ASSERT_TRUE(runTransition(SELECTOR_SPLIT)) << "split transition did not complete at " << pixels << " pixels";
+        ASSERT_TRUE(runTransition(SELECTOR_RANDOM_BARS)) << "random bars did not complete at " << pixels << " pixels";
+        EXPECT_EQ(barsTransition.barsSpan(), numPixels) << "random bars do not span the strip of " << pixels << " pixels";
+        for (uint16_t x = 0; x < numPixels; x++)
+            ASSERT_FALSE(leds[x]) << "pixel " << x << " of " << pixels << " still lit after the random bars";
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Rotating-origin strip view - random sequences of shifts and rotations of a ring must leave it with the same pixels as the same sequence
+// applied to a plain color set, whether the viewport spans the whole ring (origin moves) or not (pixels move); the output stage's copy
+// through the output curve linearizes a rotated ring into the same frame as the linear buffer.
+
+#include <gtest/gtest.h>
+#include <random>
+#include "efx_setup.h"
+#include "host_board.h"
+
+#define RING_TEST_OPS       2000    //number of random operations applied to each ring size
+
+static CRGB ringBuf[MAX_NUM_PIXELS], setBuf[MAX_NUM_PIXELS];
+
+/**
+ * Output stage exposing its output curve pass - for comparing the frames of a rotated and a linear pixel buffer
+ */
+class CurveOutput : public StripOutput {
+public:
+    void copyThroughCurve(CRGB16 *dest, const CRGB *src, const uint16_t szPixels, const uint16_t origin) {
+        if (lutDirty)
+            buildLut(255);
+        uint32_t sums[3] {};
+        FrameStats st {};
+        applyLut(dest, src, szPixels, origin, sums, st);
+    }
+};
+
+/**
+ * Applies the same random sequence of operations to a ring and to a color set over separate buffers with the same content, comparing
+ * the ring's logical pixels with the set's after each operation
+ * @param sz number of pixels of the ring and of the set
+ * @param seed random sequence seed
+ */
+static void checkRingAgainstSet(const uint16_t sz, const uint32_t seed) {
+    std::mt19937 rnd(seed);
+    for (uint16_t x = 0; x < sz; x++)
+        ringBuf[x] = setBuf[x] = CRGB(rnd(), rnd(), rnd());
+    RingSet ring(ringBuf, sz);
+    CRGBSet set(setBuf, sz);
+    for (uint16_t op = 0; op < RING_TEST_OPS; op++) {
+        const CRGB feed(rnd(), rnd(), rnd());
+        const uint16_t pos = rnd() % 4 == 0 ? rnd() % (sz * 2 + 1) : 1 + rnd() % 3;   //mostly small steps, at times past the end
+        Viewport vwp(0);
+        if (rnd() % 3 == 0) {
+            //restricted viewport - possibly extending past the end of the ring
+            const uint16_t low = rnd() % sz;
+            vwp = Viewport(low, low + 1 + rnd() % (sz - low + 2));
+        }
+        const uint8_t kind = rnd() % 3;
+        switch (kind) {
+            case 0: shiftRight(ring, feed, vwp, pos); shiftRight(set, feed, vwp, pos); break;
+            case 1: loopRight(ring, vwp, pos); loopRight(set, vwp, pos); break;
+            default: shiftLeft(ring, feed, vwp, pos); shiftLeft(set, feed, vwp, pos); break;
+        }
+        for (uint16_t x = 0; x < sz; x++)
+            ASSERT_EQ(ring[x], set[x]) << "size " << sz << " op " << op << " kind " << (int)kind << " pos " << pos << " viewport ["
+                                       << vwp.low << ", " << vwp.high << ") pixel " << x;
+    }
+    ring.linearize();
+    EXPECT_EQ(ring.origin(), 0);
+    EXPECT_EQ(memcmp(ringBuf, setBuf, sz * sizeof(CRGB)), 0) << "size " << sz << " linearized ring differs from the set";
+}
+
+TEST(RingSetTest, MatchesColorSetShifts) {
+    const uint16_t sizes[] = {1, 2, 7, FRAME_SIZE, NUM_PIXELS, MAX_NUM_PIXELS};
+    uint32_t seed = 0x21;
+    for (uint16_t sz : sizes)
+        checkRingAgainstSet(sz, seed++);
+}
+
+TEST(RingSetTest, FullViewMovesOriginOnly) {
+    for (uint16_t x = 0; x < NUM_PIXELS; x++)
+        ringBuf[x] = CRGB(x, 255 - x, x / 2);
+    memcpy(setBuf, ringBuf, NUM_PIXELS * sizeof(CRGB));
+    RingSet ring(ringBuf, NUM_PIXELS);
+    loopRight(ring, (Viewport)0, 13);
+    EXPECT_EQ(ring.origin(), NUM_PIXELS - 13);
+    EXPECT_EQ(memcmp(ringBuf, setBuf, NUM_PIXELS * sizeof(CRGB)), 0) << "rotation moved pixels";
+    shiftRight(ring, CRGB::Red, (Viewport)0, 5);
+    EXPECT_EQ(ring.origin(), NUM_PIXELS - 18);
+    //only the pixels fed in are written
+    for (uint16_t x = 0; x < NUM_PIXELS; x++) {
+        const bool fed = x >= NUM_PIXELS - 18 && x < NUM_PIXELS - 13;
+        EXPECT_EQ(ringBuf[x], fed ? CRGB(CRGB::Red) : setBuf[x]) << "pixel " << x;
+    }
+}
+
+TEST(RingSetTest, OutputCurveLinearizes) {
+    static CRGB16 rotated[MAX_NUM_PIXELS], linear[MAX_NUM_PIXELS];
+    CurveOutput output;
+    output.setGamma(OUTPUT_GAMMA);
+    std::mt19937 rnd(0x2100);
+    for (uint16_t x = 0; x < numPixels; x++)
+        ringBuf[x] = CRGB(rnd(), rnd(), rnd());
+    RingSet ring(ringBuf, numPixels);
+    for (uint16_t r = 0; r < 20; r++) {
+        loopRight(ring, (Viewport)0, 1 + rnd() % numPixels);
+        shiftLeft(ring, CRGB(rnd(), rnd(), rnd()), (Viewport)0, 1 + rnd() % 4);
+        output.copyThroughCurve(rotated, ringBuf, numPixels, ring.origin());
+        for (uint16_t x = 0; x < numPixels; x++)
+            setBuf[x] = ring[x];
+        output.copyThroughCurve(linear, setBuf, numPixels, 0);
+        ASSERT_EQ(memcmp(rotated, linear, numPixels * sizeof(CRGB16)), 0) << "round " << r << " origin " << ring.origin();
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2024 by Dan Luca. All rights reserved.
+//
+// Strip shifts - shiftRight, loopRight and shiftLeft move the pixels in blocks; random sets (forward and reversed, at random offsets in a
+// larger buffer), viewports and shift amounts must leave the very same buffer as the reference per pixel loops the block moves replaced.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "efx_setup.h"
+#include "host_board.h"
+
+#define SHIFT_TEST_CASES    20000   //number of random shifts checked for each function
+#define SHIFT_TEST_MAX_SIZE 300     //largest set shifted
+#define SHIFT_TEST_GUARD    8       //pixels around the set in the buffer, on average - must never be written
+
+static CRGB actualBuf[SHIFT_TEST_MAX_SIZE + 2*SHIFT_TEST_GUARD], expectBuf[SHIFT_TEST_MAX_SIZE + 2*SHIFT_TEST_GUARD];
+
+/**
+ * Fills a range of a set - pixel by pixel, through the set's indexing. A sub-set of a reversed set (<code>set(low, high)</code>) runs forward
+ * from the set's first pixel, off the set's memory - the reference fills do not take that path
+ */
+static void refFill(CRGBSet &set, const uint16_t low, const uint16_t high, const CRGB &color) {
+    for (uint16_t x = low; x <= high; x++)
+        set[x] = color;
+}
+
+//~ Reference implementations - pixel by pixel, through the set's indexing
+static void refShiftRight(CRGBSet &set, CRGB feedLeft, Viewport vwp, uint16_t pos) {
+    if ((pos == 0) || (set.size() == 0) || (vwp.low >= set.size()))
+        return;
+    if (vwp.size() == 0)
+        vwp = (Viewport)set.size();
+    if (pos >= vwp.size()) {
+        uint16_t hiMark = capu(vwp.high, (set.size()-1));
+        refFill(set, vwp.low, hiMark, feedLeft);
+        return;
+    }
+    uint16_t hiMark = capu(vwp.high, set.size());
+    for (uint16_t x = hiMark; x > vwp.low; x--) {
+        uint16_t y = x - 1;
+        set[y] = y < pos ? feedLeft : set[y-pos];
+    }
+}
+
+static void refLoopRight(CRGBSet &set, Viewport vwp, uint16_t pos) {
+    if ((pos == 0) || (set.size() == 0) || (vwp.low >= set.size()))
+        return;
+    if (vwp.size() == 0)
+        vwp = (Viewport)set.size();
+    uint16_t hiMark = capu(vwp.high, set.size());
+    pos = pos % vwp.size();
+    std::vector<CRGB> buf(pos);
+    for (uint16_t x = hiMark; x > vwp.low; x--) {
+        uint16_t y = x - 1;
+        if (hiMark-x < pos)
+            buf[hiMark-x] = set[y];
+        set[y] = y < pos ? buf[pos-y-1] : set[y-pos];
+    }
+}
+
+static void refShiftLeft(CRGBSet &set, CRGB feedRight, Viewport vwp, uint16_t pos) {
+    if ((pos == 0) || (set.size() == 0) || (vwp.low >= set.size()))
+        return;
+    if (vwp.size() == 0)
+        vwp = (Viewport)set.size();
+    uint16_t hiMark = capu(vwp.high, (set.size()-1));
+    if (pos >= vwp.size()) {
+        refFill(set, vwp.low, hiMark, feedRight);
+        return;
+    }
+    for (uint16_t x = vwp.low; x <= hiMark; x++) {
+        uint16_t y = x + pos;
+        set[x] = y < set.size() ? set[y] : feedRight;
+    }
+}
+
+enum ShiftKind:uint8_t {ShiftRight, LoopRight, ShiftLeft};
+
+/**
+ * Runs random shifts of one kind through the block implementation and the reference, over identical buffers, and compares the buffers
+ * @param kind the shift function checked
+ * @param seed random sequence seed
+ */
+static void checkShifts(const ShiftKind kind, const uint32_t seed) {
+    std::mt19937 rnd(seed);
+    for (uint32_t c = 0; c < SHIFT_TEST_CASES; c++) {
+        const uint16_t sz = 1 + rnd() % SHIFT_TEST_MAX_SIZE;
+        const bool reversed = rnd() & 0x01;
+        for (auto &px : actualBuf)
+            px = CRGB(rnd(), rnd(), rnd());
+        memcpy(expectBuf, actualBuf, sizeof(actualBuf));
+        const uint16_t first = rnd() % (2*SHIFT_TEST_GUARD + 1), last = first + sz - 1;
+        CRGBSet actual = reversed ? CRGBSet(actualBuf, last, first) : CRGBSet(actualBuf, first, last);
+        CRGBSet expect = reversed ? CRGBSet(expectBuf, last, first) : CRGBSet(expectBuf, first, last);
+        //viewport - whole set (empty), or a random range; the shifts take ranges past the set's end, the rotation only within the set
+        Viewport vwp(0);
+        if (rnd() % 4 != 0) {
+            const uint16_t low = rnd() % (sz + 1);
+            const uint16_t maxHigh = kind == LoopRight ? sz : sz + 4;
+            vwp = Viewport(low, low + rnd() % (maxHigh - min(low, maxHigh) + 1));
+        }
+        //mostly small shifts, at times up to past the set's end
+        const uint16_t pos = rnd() % 3 == 0 ? rnd() % (2*sz + 2) : rnd() % 5;
+        const CRGB feed(rnd(), rnd(), rnd());
+        switch (kind) {
+            case ShiftRight: shiftRight(actual, feed, vwp, pos); refShiftRight(expect, feed, vwp, pos); break;
+            case LoopRight: loopRight(actual, vwp, pos); refLoopRight(expect, vwp, pos); break;
+            case ShiftLeft: shiftLeft(actual, feed, vwp, pos); refShiftLeft(expect, feed, vwp, pos); break;
+        }
+        for (uint16_t x = 0; x < arrSize(actualBuf); x++)
+            ASSERT_EQ(actualBuf[x], expectBuf[x]) << "case " << c << " size " << sz << (reversed ? " reversed" : " forward") << " viewport ["
+                                                  << vwp.low << ", " << vwp.high << ") pos " << pos << " buffer pixel " << x
+                                                  << " (set spans " << first << ".." << last << ")";
+    }
+}
+
+TEST(ShiftsTest, ShiftRightMatchesReference) {
+    checkShifts(ShiftRight, 0x5121);
+}
+
+TEST(ShiftsTest, LoopRightMatchesReference) {
+    checkShifts(LoopRight, 0x1002);
+}
+
+TEST(ShiftsTest, ShiftLeftMatchesReference) {
+    checkShifts(ShiftLeft, 0x5151);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}